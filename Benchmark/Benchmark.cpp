@@ -0,0 +1,836 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "WMath/WMath.hpp"
+
+namespace
+{
+    struct Result
+    {
+        std::string name;
+        double nanosecondsPerOperation;
+        double operationsPerSecond;
+        std::size_t operations;
+    };
+
+    template<typename T>
+    void DoNotOptimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile char sink;
+        sink = *reinterpret_cast<const volatile char*>(&value);
+#endif
+    }
+
+    class Benchmark
+    {
+    public:
+        explicit Benchmark(double minimumSeconds) : minimumSeconds(minimumSeconds) {}
+
+        // The body runs operationsPerCall operations per call and is repeated until minimumSeconds have elapsed.
+        void Run(const std::string& name, std::size_t operationsPerCall, const std::function<void()>& body)
+        {
+            body();
+
+            std::size_t calls = 0;
+            const auto start = std::chrono::steady_clock::now();
+            auto now = start;
+            do
+            {
+                for(int i = 0; i < 8; i++) body();
+                calls += 8;
+                now = std::chrono::steady_clock::now();
+            } while(std::chrono::duration<double>(now - start).count() < minimumSeconds);
+
+            const double seconds = std::chrono::duration<double>(now - start).count();
+            const std::size_t operations = calls * operationsPerCall;
+            results.push_back({name, seconds * 1e9 / static_cast<double>(operations), static_cast<double>(operations) / seconds, operations});
+
+            const Result& result = results.back();
+            std::printf("%-40s %12.3f ns/op %14.2f Mop/s\n", result.name.c_str(), result.nanosecondsPerOperation, result.operationsPerSecond / 1e6);
+        }
+
+        bool WriteJson(const std::string& path) const
+        {
+            std::ofstream file(path);
+            if(!file) return false;
+
+            file << "{\n  \"benchmarks\": [\n";
+            for(std::size_t i = 0; i < results.size(); i++)
+            {
+                const Result& result = results[i];
+                file << "    {\"name\": \"" << result.name << "\", \"ns_per_op\": " << result.nanosecondsPerOperation
+                    << ", \"ops_per_second\": " << result.operationsPerSecond << ", \"operations\": " << result.operations << "}"
+                    << (i + 1 < results.size() ? ",\n" : "\n");
+            }
+            file << "  ]\n}\n";
+            return static_cast<bool>(file);
+        }
+
+    private:
+        double minimumSeconds;
+        std::vector<Result> results;
+    };
+
+    constexpr std::size_t Count = 4096;
+
+    void RunUtils(Benchmark& benchmark, const std::vector<float>& values)
+    {
+        benchmark.Run("Utils/Sqrt", Count, [&]
+        {
+            float sum = 0;
+            for(const float value : values) sum += WMath::Sqrt(value);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Utils/Sin", Count, [&]
+        {
+            float sum = 0;
+            for(const float value : values) sum += WMath::Sin(value);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Utils/Atan2", Count, [&]
+        {
+            float sum = 0;
+            for(std::size_t i = 1; i < values.size(); i++) sum += WMath::Atan2(values[i - 1], values[i]);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Utils/Exp", Count, [&]
+        {
+            float sum = 0;
+            for(const float value : values) sum += WMath::Exp(value);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Fast/Sqrt", Count, [&]
+        {
+            float sum = 0;
+            for(const float value : values) sum += WMath::Fast::Sqrt(value);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Fast/InvSqrt", Count, [&]
+        {
+            float sum = 0;
+            for(const float value : values) sum += WMath::Fast::InvSqrt(value);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Fast/Sin", Count, [&]
+        {
+            float sum = 0;
+            for(const float value : values) sum += WMath::Fast::Sin(value);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Fast/SinCos", Count, [&]
+        {
+            float sum = 0;
+            for(const float value : values)
+            {
+                float sin, cos;
+                WMath::Fast::SinCos(value, sin, cos);
+                sum += sin + cos;
+            }
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Fast/Atan2", Count, [&]
+        {
+            float sum = 0;
+            for(std::size_t i = 1; i < values.size(); i++) sum += WMath::Fast::Atan2(values[i - 1], values[i]);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Fast/Exp", Count, [&]
+        {
+            float sum = 0;
+            for(const float value : values) sum += WMath::Fast::Exp(value);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Fast/Ln", Count, [&]
+        {
+            float sum = 0;
+            for(const float value : values) sum += WMath::Fast::Ln(value);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Utils/Ln", Count, [&]
+        {
+            float sum = 0;
+            for(const float value : values) sum += WMath::Ln(value);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Utils/Lerp", Count, [&]
+        {
+            float sum = 0;
+            for(const float value : values) sum += WMath::Lerp(-1.0f, 1.0f, value);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Utils/Clamp", Count, [&]
+        {
+            float sum = 0;
+            for(const float value : values) sum += WMath::Clamp(value, 0.25f, 0.75f);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Utils/SmoothStep", Count, [&]
+        {
+            float sum = 0;
+            for(const float value : values) sum += WMath::SmoothStep(0.0f, 1.0f, value);
+            DoNotOptimize(sum);
+        });
+    }
+
+    void RunBatch(Benchmark& benchmark, const std::vector<float>& values)
+    {
+        std::vector<float> out(Count);
+        std::vector<float> cos(Count);
+
+        benchmark.Run("Batch/Sin", Count, [&]
+        {
+            WMath::Batch::Sin(values, out);
+            DoNotOptimize(out.data());
+        });
+        benchmark.Run("Batch/SinCos", Count, [&]
+        {
+            WMath::Batch::SinCos(values, out, cos);
+            DoNotOptimize(out.data());
+            DoNotOptimize(cos.data());
+        });
+        benchmark.Run("Batch/Atan2", Count, [&]
+        {
+            WMath::Batch::Atan2(values, out, out);
+            DoNotOptimize(out.data());
+        });
+        benchmark.Run("Batch/Exp", Count, [&]
+        {
+            WMath::Batch::Exp(values, out);
+            DoNotOptimize(out.data());
+        });
+        benchmark.Run("Batch/Pow", Count, [&]
+        {
+            WMath::Batch::Pow(values, 2.2f, out);
+            DoNotOptimize(out.data());
+        });
+        benchmark.Run("Batch/SmoothStep", Count, [&]
+        {
+            WMath::Batch::SmoothStep(0.25f, 0.75f, values, out);
+            DoNotOptimize(out.data());
+        });
+    }
+
+    void RunVectors(Benchmark& benchmark, const std::vector<WMath::Vector2>& vectors2, const std::vector<WMath::Vector3>& vectors3)
+    {
+        std::vector<WMath::Vector2> out2(Count);
+        std::vector<WMath::Vector3> out3(Count);
+
+        benchmark.Run("Vector2/Add", Count, [&]
+        {
+            for(std::size_t i = 1; i < Count; i++) out2[i] = vectors2[i] + vectors2[i - 1];
+            DoNotOptimize(out2.data());
+        });
+        benchmark.Run("Vector2/Normalized", Count, [&]
+        {
+            for(std::size_t i = 0; i < Count; i++) out2[i] = vectors2[i].Normalized();
+            DoNotOptimize(out2.data());
+        });
+        benchmark.Run("Vector2/Slerp", Count, [&]
+        {
+            for(std::size_t i = 1; i < Count; i++) out2[i] = WMath::Vector2::Slerp(vectors2[i], vectors2[i - 1], 0.5f);
+            DoNotOptimize(out2.data());
+        });
+        benchmark.Run("Vector2/Angle<Fast>", Count, [&]
+        {
+            float sum = 0;
+            for(std::size_t i = 1; i < Count; i++) sum += WMath::Vector2::Angle<WMath::Precision::Fast>(vectors2[i], vectors2[i - 1]);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Vector3/Add", Count, [&]
+        {
+            for(std::size_t i = 1; i < Count; i++) out3[i] = vectors3[i] + vectors3[i - 1];
+            DoNotOptimize(out3.data());
+        });
+        benchmark.Run("Vector3/Dot", Count, [&]
+        {
+            float sum = 0;
+            for(std::size_t i = 1; i < Count; i++) sum += WMath::Vector3::Dot(vectors3[i], vectors3[i - 1]);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Vector3/Cross", Count, [&]
+        {
+            for(std::size_t i = 1; i < Count; i++) out3[i] = WMath::Vector3::Cross(vectors3[i], vectors3[i - 1]);
+            DoNotOptimize(out3.data());
+        });
+        benchmark.Run("Vector3/Distance", Count, [&]
+        {
+            float sum = 0;
+            for(std::size_t i = 1; i < Count; i++) sum += WMath::Vector3::Distance(vectors3[i], vectors3[i - 1]);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Vector3/Normalized", Count, [&]
+        {
+            for(std::size_t i = 0; i < Count; i++) out3[i] = vectors3[i].Normalized();
+            DoNotOptimize(out3.data());
+        });
+        benchmark.Run("Vector3/Slerp", Count, [&]
+        {
+            for(std::size_t i = 1; i < Count; i++) out3[i] = WMath::Vector3::Slerp(vectors3[i], vectors3[i - 1], 0.5f);
+            DoNotOptimize(out3.data());
+        });
+        benchmark.Run("Vector3/Normalized<Fast>", Count, [&]
+        {
+            for(std::size_t i = 0; i < Count; i++) out3[i] = vectors3[i].Normalized<WMath::Precision::Fast>();
+            DoNotOptimize(out3.data());
+        });
+        benchmark.Run("Vector3/Slerp<Fast>", Count, [&]
+        {
+            for(std::size_t i = 1; i < Count; i++) out3[i] = WMath::Vector3::Slerp<WMath::Precision::Fast>(vectors3[i], vectors3[i - 1], 0.5f);
+            DoNotOptimize(out3.data());
+        });
+
+        const WMath::Vector3Array array(vectors3);
+        WMath::Vector3Array arrayOut;
+        benchmark.Run("Vector3Array/Normalize", Count, [&]
+        {
+            WMath::Vector3Array::Normalize(array, arrayOut);
+            DoNotOptimize(arrayOut.x.data());
+        });
+    }
+
+    void RunRandom(Benchmark& benchmark, const std::vector<WMath::Vector3>& vectors3)
+    {
+        benchmark.Run("Random/GetValue(float)", Count, [&]
+        {
+            float sum = 0;
+            for(std::size_t i = 0; i < Count; i++) sum += WMath::Random::GetValue(0.0f, 1.0f);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Random/GetValue(int)", Count, [&]
+        {
+            int sum = 0;
+            for(std::size_t i = 0; i < Count; i++) sum += WMath::Random::GetValue(0, 100);
+            DoNotOptimize(sum);
+        });
+        std::vector<WMath::Vector3> out3(Count);
+        benchmark.Run("Random/GetVector3", Count, [&]
+        {
+            for(std::size_t i = 0; i < Count; i++) out3[i] = WMath::Random::GetVector3(-1.0f, 1.0f);
+            DoNotOptimize(out3.data());
+        });
+        benchmark.Run("Random/FillVector3", Count, [&]
+        {
+            WMath::Random::FillVector3(out3, -1.0f, 1.0f);
+            DoNotOptimize(out3.data());
+        });
+        const WMath::CounterRandom counterRandom(1234);
+        benchmark.Run("CounterRandom/GetValue(float)", Count, [&]
+        {
+            float sum = 0;
+            for(std::size_t i = 0; i < Count; i++) sum += counterRandom.GetValue(i, 0.0f, 1.0f);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("CounterRandom/FillVector3", Count, [&]
+        {
+            counterRandom.FillVector3(0, out3, -1.0f, 1.0f);
+            DoNotOptimize(out3.data());
+        });
+        benchmark.Run("CounterRandom/FillVector3(parallel)", Count, [&]
+        {
+            counterRandom.FillVector3(0, out3, -1.0f, 1.0f, 0);
+            DoNotOptimize(out3.data());
+        });
+
+        WMath::RandomStream& stream = WMath::Random::GetStream();
+        benchmark.Run("Sampling/OnUnitSphere", Count, [&]
+        {
+            for(std::size_t i = 0; i < Count; i++) out3[i] = WMath::Sampling::OnUnitSphere(stream);
+            DoNotOptimize(out3.data());
+        });
+        benchmark.Run("Sampling/FillOnUnitSphere", Count, [&]
+        {
+            WMath::Sampling::FillOnUnitSphere(stream, std::span<WMath::Vector3>(out3));
+            DoNotOptimize(out3.data());
+        });
+        std::vector<float> gaussian(Count);
+        benchmark.Run("Sampling/Normal(std)", Count, [&]
+        {
+            std::normal_distribution<float> distribution(0.0f, 1.0f);
+            for(std::size_t i = 0; i < Count; i++) gaussian[i] = distribution(stream.GetGenerator());
+            DoNotOptimize(gaussian.data());
+        });
+        benchmark.Run("Sampling/FillNormal", Count, [&]
+        {
+            WMath::Sampling::FillNormal(stream, std::span<float>(gaussian));
+            DoNotOptimize(gaussian.data());
+        });
+
+        std::vector<float> weights(1000);
+        for(std::size_t i = 0; i < weights.size(); i++) weights[i] = static_cast<float>(i % 17 + 1);
+        const WMath::Sampling::AliasTable table(weights);
+        std::vector<std::uint32_t> choices(Count);
+        benchmark.Run("Sampling/WeightedChoice(std)", Count, [&]
+        {
+            std::discrete_distribution<std::uint32_t> distribution(weights.begin(), weights.end());
+            for(std::size_t i = 0; i < Count; i++) choices[i] = distribution(stream.GetGenerator());
+            DoNotOptimize(choices.data());
+        });
+        benchmark.Run("Sampling/AliasTable::Sample", Count, [&]
+        {
+            for(std::size_t i = 0; i < Count; i++) choices[i] = table.Sample(stream);
+            DoNotOptimize(choices.data());
+        });
+        benchmark.Run("Sampling/AliasTable::Fill", Count, [&]
+        {
+            table.Fill(stream, std::span<std::uint32_t>(choices));
+            DoNotOptimize(choices.data());
+        });
+
+        benchmark.Run("Random/GetNoise(2D)", Count, [&]
+        {
+            float sum = 0;
+            for(std::size_t i = 0; i < Count; i++) sum += WMath::Random::GetNoise(vectors3[i].x, vectors3[i].y);
+            DoNotOptimize(sum);
+        });
+        benchmark.Run("Random/GetNoise(3D)", Count, [&]
+        {
+            float sum = 0;
+            for(std::size_t i = 0; i < Count; i++) sum += WMath::Random::GetNoise(vectors3[i].x, vectors3[i].y, vectors3[i].z);
+            DoNotOptimize(sum);
+        });
+        std::vector<float> noise(Count);
+        benchmark.Run("Random/GenerateNoise(3D)", Count, [&]
+        {
+            WMath::Random::GenerateNoise(std::span<const WMath::Vector3>(vectors3), noise);
+            DoNotOptimize(noise.data());
+        });
+    }
+
+    void RunGeometry(Benchmark& benchmark, const std::vector<WMath::Vector3>& vectors3)
+    {
+        std::vector<WMath::Ray> rays(Count);
+        std::vector<WMath::Triangle> triangles(Count);
+        std::vector<WMath::AABB> boxes(Count);
+        for(std::size_t i = 0; i < Count; i++)
+        {
+            const WMath::Vector3& point = vectors3[i];
+            rays[i] = WMath::Ray(point, vectors3[(i + 1) % Count] - point);
+            triangles[i] = WMath::Triangle(point, vectors3[(i + 7) % Count], vectors3[(i + 13) % Count]);
+            boxes[i] = WMath::AABB::FromCenter(point, WMath::Vector3(10.0f));
+        }
+        const WMath::Triangle& triangle = triangles[0];
+        const WMath::AABB& box = boxes[0];
+
+        std::vector<float> distances(Count);
+        benchmark.Run("Geometry/Triangle.Raycast", Count, [&]
+        {
+            for(std::size_t i = 0; i < Count; i++)
+            {
+                float distance = 0;
+                triangle.Raycast(rays[i], distance);
+                distances[i] = distance;
+            }
+            DoNotOptimize(distances.data());
+        });
+        benchmark.Run("Batch/Raycast(rays, Triangle)", Count, [&]
+        {
+            WMath::Batch::Raycast(rays, triangle, distances);
+            DoNotOptimize(distances.data());
+        });
+        benchmark.Run("Batch/Raycast(ray, Triangles)", Count, [&]
+        {
+            WMath::Batch::Raycast(rays[0], triangles, distances);
+            DoNotOptimize(distances.data());
+        });
+        benchmark.Run("Geometry/AABB.Raycast", Count, [&]
+        {
+            for(std::size_t i = 0; i < Count; i++)
+            {
+                float distance = 0;
+                box.Raycast(rays[i], distance);
+                distances[i] = distance;
+            }
+            DoNotOptimize(distances.data());
+        });
+        benchmark.Run("Batch/Raycast(rays, AABB)", Count, [&]
+        {
+            WMath::Batch::Raycast(rays, box, distances);
+            DoNotOptimize(distances.data());
+        });
+        benchmark.Run("Batch/Raycast(ray, AABBs)", Count, [&]
+        {
+            WMath::Batch::Raycast(rays[0], boxes, distances);
+            DoNotOptimize(distances.data());
+        });
+    }
+
+    void RunCulling(Benchmark& benchmark)
+    {
+        constexpr std::size_t SphereCount = 200000;
+        const WMath::Frustum frustum(WMath::Matrix4x4::Perspective(60.0f, 16.0f / 9.0f, 0.5f, 80.0f) *
+            WMath::Matrix4x4::LookAt(WMath::Vector3(0, 0, -30), WMath::Vector3::Zero(), WMath::Vector3::Up()));
+        std::vector<WMath::Vector3> centers(SphereCount);
+        std::vector<float> radii(SphereCount);
+        WMath::Random::FillVector3(centers, -100.0f, 100.0f);
+        WMath::Random::FillUniform(radii, 0.0f, 3.0f);
+        std::vector<WMath::Sphere> spheres(SphereCount);
+        for(std::size_t i = 0; i < SphereCount; i++) spheres[i] = WMath::Sphere(centers[i], radii[i]);
+        const WMath::Vector3Array centerArray(centers);
+        const WMath::Vector3Array extentArray(SphereCount, WMath::Vector3(1.5f));
+
+        std::vector<std::uint32_t> visible(SphereCount);
+        benchmark.Run("Frustum/Intersects(Sphere)", SphereCount, [&]
+        {
+            std::size_t found = 0;
+            for(std::uint32_t i = 0; i < SphereCount; i++)
+            {
+                visible[found] = i;
+                found += frustum.Intersects(spheres[i]);
+            }
+            DoNotOptimize(visible.data());
+        });
+        benchmark.Run("Culling/Spheres(200k)", SphereCount, [&]
+        {
+            DoNotOptimize(WMath::Culling::Spheres(frustum, centerArray, radii, visible));
+        });
+        benchmark.Run("Culling/Spheres(200k, pool)", SphereCount, [&]
+        {
+            DoNotOptimize(WMath::Culling::Spheres(frustum, centerArray, radii, visible, 0));
+        });
+        benchmark.Run("Culling/Boxes(200k)", SphereCount, [&]
+        {
+            DoNotOptimize(WMath::Culling::Boxes(frustum, centerArray, extentArray, visible));
+        });
+    }
+
+    void RunParticles(Benchmark& benchmark)
+    {
+        constexpr std::size_t ParticleCount = 1 << 20;
+        constexpr float deltaTime = 1.0f / 60.0f;
+        std::vector<WMath::Vector3> positions(ParticleCount);
+        std::vector<WMath::Vector3> velocities(ParticleCount);
+        std::vector<WMath::Vector3> accelerations(ParticleCount, WMath::Vector3(0, -9.81f, 0));
+        WMath::Random::FillVector3(positions, -100.0f, 100.0f);
+        WMath::Random::FillVector3(velocities, -1.0f, 1.0f);
+
+        WMath::ParticleBuffer particles(ParticleCount);
+        for(std::size_t i = 0; i < ParticleCount; i++)
+        {
+            particles.positions.Set(i, positions[i]);
+            particles.velocities.Set(i, velocities[i]);
+            particles.accelerations.Set(i, accelerations[i]);
+        }
+        const WMath::Vector3Array targets(positions);
+
+        benchmark.Run("Vector3/SemiImplicitEuler(1M)", ParticleCount, [&]
+        {
+            for(std::size_t i = 0; i < ParticleCount; i++)
+            {
+                velocities[i] += accelerations[i] * deltaTime;
+                positions[i] += velocities[i] * deltaTime;
+            }
+            DoNotOptimize(positions.data());
+        });
+        benchmark.Run("Integration/SemiImplicitEuler(1M)", ParticleCount, [&]
+        {
+            WMath::Integration::SemiImplicitEuler(particles, deltaTime);
+            DoNotOptimize(particles.positions.x.data());
+        });
+        benchmark.Run("Integration/SemiImplicitEuler(1M, pool)", ParticleCount, [&]
+        {
+            WMath::Integration::SemiImplicitEuler(particles, deltaTime, 0);
+            DoNotOptimize(particles.positions.x.data());
+        });
+        benchmark.Run("Integration/Verlet(1M)", ParticleCount, [&]
+        {
+            WMath::Integration::Verlet(particles, deltaTime);
+            DoNotOptimize(particles.positions.x.data());
+        });
+        benchmark.Run("Integration/DampedSpring(1M)", ParticleCount, [&]
+        {
+            WMath::Integration::DampedSpring(particles, targets, 20.0f, 2.0f, deltaTime);
+            DoNotOptimize(particles.positions.x.data());
+        });
+
+        // Refilling the lifetimes is part of the measured time.
+        std::vector<float> lifetimes(ParticleCount);
+        WMath::Random::FillUniform(lifetimes, -1.0f, 1.0f);
+        benchmark.Run("ParticleBuffer/Compact(1M, half expired)", ParticleCount, [&]
+        {
+            particles.Resize(ParticleCount);
+            std::copy(lifetimes.begin(), lifetimes.end(), particles.lifetimes.begin());
+            DoNotOptimize(particles.Compact());
+        });
+    }
+
+    void RunParallel(Benchmark& benchmark)
+    {
+        constexpr std::size_t LargeCount = 1 << 20;
+        std::vector<WMath::Vector3> vectors(LargeCount);
+        std::vector<WMath::Vector3> normalized(LargeCount);
+        std::vector<float> values(LargeCount);
+        WMath::Random::FillVector3(vectors, -100.0f, 100.0f);
+        WMath::Random::FillUniform(values, 0.0f, 1.0f);
+
+        const auto normalize = [](const WMath::Vector3& vector) { return vector.Normalized<WMath::Precision::Fast>(); };
+        benchmark.Run("Serial/Normalize(1M)", LargeCount, [&]
+        {
+            for(std::size_t i = 0; i < LargeCount; i++) normalized[i] = normalize(vectors[i]);
+            DoNotOptimize(normalized.data());
+        });
+        benchmark.Run("Parallel/Normalize(1M)", LargeCount, [&]
+        {
+            WMath::Parallel::Transform(std::span<const WMath::Vector3>(vectors), std::span<WMath::Vector3>(normalized), normalize);
+            DoNotOptimize(normalized.data());
+        });
+        benchmark.Run("Parallel/Reduce(1M)", LargeCount, [&]
+        {
+            DoNotOptimize(WMath::Parallel::Reduce(std::span<const float>(values), 0.0f, [](float a, float b) { return a + b; }));
+        });
+    }
+
+    void RunQuantization(Benchmark& benchmark, const std::vector<WMath::Vector3>& vectors3)
+    {
+        std::vector<WMath::Vector3> normals(Count);
+        for(std::size_t i = 0; i < Count; i++) normals[i] = vectors3[i].Normalized();
+        std::vector<std::uint32_t> octahedral(Count);
+        std::vector<WMath::Vector3> decoded(Count);
+        benchmark.Run("Quantization/EncodeOctahedral32", Count, [&]
+        {
+            for(std::size_t i = 0; i < Count; i++) octahedral[i] = WMath::Quantization::EncodeOctahedral32(normals[i]);
+            DoNotOptimize(octahedral.data());
+        });
+        benchmark.Run("Quantization/EncodeOctahedral32(batch)", Count, [&]
+        {
+            WMath::Quantization::EncodeOctahedral32(normals, octahedral);
+            DoNotOptimize(octahedral.data());
+        });
+        benchmark.Run("Quantization/DecodeOctahedral32(batch)", Count, [&]
+        {
+            WMath::Quantization::DecodeOctahedral32(octahedral, decoded);
+            DoNotOptimize(decoded.data());
+        });
+
+        const WMath::Quantization::PositionCodec codec(WMath::AABB::FromPoints(vectors3));
+        std::vector<WMath::Quantization::PackedPosition48> positions(Count);
+        benchmark.Run("Quantization/Encode48", Count, [&]
+        {
+            for(std::size_t i = 0; i < Count; i++) positions[i] = codec.Encode48(vectors3[i]);
+            DoNotOptimize(positions.data());
+        });
+        benchmark.Run("Quantization/Encode48(batch)", Count, [&]
+        {
+            codec.Encode48(vectors3, positions);
+            DoNotOptimize(positions.data());
+        });
+        benchmark.Run("Quantization/Decode48(batch)", Count, [&]
+        {
+            codec.Decode48(positions, decoded);
+            DoNotOptimize(decoded.data());
+        });
+    }
+
+    void RunHalf(Benchmark& benchmark, const std::vector<float>& values, const std::vector<WMath::Vector3>& vectors3)
+    {
+        std::vector<WMath::Half> halves(Count);
+        std::vector<WMath::BFloat16> bfloats(Count);
+        std::vector<float> widened(Count);
+        benchmark.Run("Half/ToHalf", Count, [&]
+        {
+            for(std::size_t i = 0; i < Count; i++) halves[i] = WMath::Half(values[i]);
+            DoNotOptimize(halves.data());
+        });
+        benchmark.Run("Half/ToHalf(batch)", Count, [&]
+        {
+            WMath::ToHalf(values, halves);
+            DoNotOptimize(halves.data());
+        });
+        benchmark.Run("Half/ToFloat(batch)", Count, [&]
+        {
+            WMath::ToFloat(std::span<const WMath::Half>(halves), widened);
+            DoNotOptimize(widened.data());
+        });
+        benchmark.Run("Half/ToBFloat16(batch)", Count, [&]
+        {
+            WMath::ToBFloat16(values, bfloats);
+            DoNotOptimize(bfloats.data());
+        });
+        benchmark.Run("Half/ToFloat(bfloat16, batch)", Count, [&]
+        {
+            WMath::ToFloat(std::span<const WMath::BFloat16>(bfloats), widened);
+            DoNotOptimize(widened.data());
+        });
+
+        std::vector<WMath::Vector3h> packed(Count);
+        std::vector<WMath::Vector3> decoded(Count);
+        benchmark.Run("Half/Vector3h(batch)", Count, [&]
+        {
+            WMath::ToHalf(vectors3, packed);
+            DoNotOptimize(packed.data());
+        });
+        benchmark.Run("Half/Vector3(batch)", Count, [&]
+        {
+            WMath::ToFloat(std::span<const WMath::Vector3h>(packed), decoded);
+            DoNotOptimize(decoded.data());
+        });
+    }
+
+    void RunBroadphase(Benchmark& benchmark)
+    {
+        // About 1.5 points per unit cell, queried at a radius of one cell.
+        constexpr float radius = 1.0f;
+        std::vector<WMath::Vector3> points(100000);
+        WMath::Random::FillVector3(points, -20.0f, 20.0f);
+        std::vector<WMath::Vector3> moved(points.size());
+        for(std::size_t i = 0; i < points.size(); i++) moved[i] = points[i] + WMath::Random::GetVector3(-0.05f, 0.05f);
+        std::vector<WMath::IndexPair> pairs;
+
+        WMath::SpatialHash hash(radius);
+        benchmark.Run("SpatialHash/Build(100k)", points.size(), [&]
+        {
+            hash.Build(points, 0);
+            DoNotOptimize(hash.Size());
+        });
+        benchmark.Run("SpatialHash/Update(100k)", points.size(), [&]
+        {
+            hash.Update(moved);
+            hash.Update(points);
+            DoNotOptimize(hash.Size());
+        });
+        benchmark.Run("SpatialHash/FindPairs(100k)", points.size(), [&]
+        {
+            hash.FindPairs(radius, pairs, 0);
+            DoNotOptimize(pairs.data());
+        });
+
+        WMath::SweepAndPrune sweep;
+        benchmark.Run("SweepAndPrune/Build(100k)", points.size(), [&]
+        {
+            sweep.Build(points, 0);
+            DoNotOptimize(sweep.Size());
+        });
+        benchmark.Run("SweepAndPrune/Update(100k)", points.size(), [&]
+        {
+            sweep.Update(moved, 0);
+            sweep.Update(points, 0);
+            DoNotOptimize(sweep.Size());
+        });
+        benchmark.Run("SweepAndPrune/FindPairs(100k)", points.size(), [&]
+        {
+            sweep.FindPairs(radius, pairs, 0);
+            DoNotOptimize(pairs.data());
+        });
+
+        benchmark.Run("BruteForce/FindPairs(4k)", 4096, [&]
+        {
+            pairs.clear();
+            for(std::uint32_t i = 0; i < 4096; i++)
+            {
+                for(std::uint32_t j = i + 1; j < 4096; j++)
+                {
+                    if((points[i] - points[j]).MagnitudeSquared() <= radius * radius) pairs.push_back({i, j});
+                }
+            }
+            DoNotOptimize(pairs.data());
+        });
+    }
+
+    void RunSpatial(Benchmark& benchmark, const std::vector<WMath::Vector3>& vectors3)
+    {
+        std::vector<WMath::Vector3> points(1 << 17);
+        WMath::Random::FillVector3(points, -100.0f, 100.0f);
+
+        benchmark.Run("KdTree/Build", points.size(), [&]
+        {
+            WMath::KdTree tree(points);
+            DoNotOptimize(tree.Size());
+        });
+
+        const WMath::KdTree tree(points);
+        benchmark.Run("KdTree/Nearest", Count, [&]
+        {
+            std::uint32_t sum = 0;
+            for(std::size_t i = 0; i < Count; i++) sum += tree.Nearest(vectors3[i]);
+            DoNotOptimize(sum);
+        });
+        std::vector<WMath::KdTree::Neighbor> neighbors(Count * 8);
+        benchmark.Run("KdTree/KNearest(8)", Count, [&]
+        {
+            tree.KNearest(vectors3, 8, neighbors);
+            DoNotOptimize(neighbors.data());
+        });
+        std::vector<std::uint32_t> found;
+        benchmark.Run("KdTree/Radius(10)", Count, [&]
+        {
+            found.clear();
+            for(std::size_t i = 0; i < Count; i++) tree.Radius(vectors3[i], 10.0f, found);
+            DoNotOptimize(found.data());
+        });
+        benchmark.Run("BruteForce/Nearest", 64, [&]
+        {
+            std::uint32_t sum = 0;
+            for(std::size_t i = 0; i < 64; i++)
+            {
+                std::uint32_t nearest = 0;
+                float nearestDistance = std::numeric_limits<float>::infinity();
+                for(std::uint32_t j = 0; j < points.size(); j++)
+                {
+                    const float distance = (points[j] - vectors3[i]).MagnitudeSquared();
+                    if(distance < nearestDistance)
+                    {
+                        nearest = j;
+                        nearestDistance = distance;
+                    }
+                }
+                sum += nearest;
+            }
+            DoNotOptimize(sum);
+        });
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::string jsonPath = "benchmark.json";
+    double minimumSeconds = 0.2;
+    for(int i = 1; i < argc; i++)
+    {
+        if(std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) jsonPath = argv[++i];
+        else if(std::strcmp(argv[i], "--time") == 0 && i + 1 < argc) minimumSeconds = std::atof(argv[++i]);
+        else
+        {
+            std::printf("Usage: %s [--json path] [--time seconds]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    WMath::Random::Seed(1234);
+    std::vector<float> values(Count);
+    std::vector<WMath::Vector2> vectors2(Count);
+    std::vector<WMath::Vector3> vectors3(Count);
+    WMath::Random::FillUniform(values, 0.0f, 1.0f);
+    WMath::Random::FillVector2(vectors2, -100.0f, 100.0f);
+    WMath::Random::FillVector3(vectors3, -100.0f, 100.0f);
+
+    Benchmark benchmark(minimumSeconds);
+    RunUtils(benchmark, values);
+    RunBatch(benchmark, values);
+    RunVectors(benchmark, vectors2, vectors3);
+    RunRandom(benchmark, vectors3);
+    RunGeometry(benchmark, vectors3);
+    RunCulling(benchmark);
+    RunParallel(benchmark);
+    RunParticles(benchmark);
+    RunSpatial(benchmark, vectors3);
+    RunBroadphase(benchmark);
+    RunQuantization(benchmark, vectors3);
+    RunHalf(benchmark, values, vectors3);
+
+    if(!benchmark.WriteJson(jsonPath))
+    {
+        std::printf("Failed to write %s\n", jsonPath.c_str());
+        return 1;
+    }
+    std::printf("Results written to %s\n", jsonPath.c_str());
+    return 0;
+}
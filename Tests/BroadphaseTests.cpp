@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "Check.hpp"
+#include "WMath/Broadphase.hpp"
+
+// Checks SpatialHash and SweepAndPrune pair and radius queries against brute force, after Build and after both kinds
+// of Update, for serial and parallel calls.
+namespace
+{
+    bool Within(const WMath::Vector3& a, const WMath::Vector3& b, float radius)
+    {
+        return (a - b).MagnitudeSquared() <= radius * radius;
+    }
+
+    bool Less(const WMath::IndexPair& lhs, const WMath::IndexPair& rhs)
+    {
+        return std::tie(lhs.first, lhs.second) < std::tie(rhs.first, rhs.second);
+    }
+
+    bool Equal(const WMath::IndexPair& lhs, const WMath::IndexPair& rhs)
+    {
+        return lhs.first == rhs.first && lhs.second == rhs.second;
+    }
+
+    std::vector<WMath::IndexPair> BrutePairs(const std::vector<WMath::Vector3>& points, float radius)
+    {
+        std::vector<WMath::IndexPair> pairs;
+        for(std::uint32_t i = 0; i < points.size(); i++)
+        {
+            for(std::uint32_t j = i + 1; j < points.size(); j++)
+            {
+                if(Within(points[i], points[j], radius)) pairs.push_back({i, j});
+            }
+        }
+        return pairs;
+    }
+
+    template<typename Broadphase>
+    void CheckQueries(const Broadphase& broadphase, const std::vector<WMath::Vector3>& points, const std::vector<WMath::Vector3>& centers,
+        float radius, unsigned threadCount)
+    {
+        std::vector<WMath::IndexPair> pairs;
+        broadphase.FindPairs(radius, pairs, threadCount);
+        for(const WMath::IndexPair& pair : pairs) WMATH_CHECK(pair.first < pair.second);
+        std::sort(pairs.begin(), pairs.end(), Less);
+        const std::vector<WMath::IndexPair> expected = BrutePairs(points, radius);
+        WMATH_CHECK(std::equal(pairs.begin(), pairs.end(), expected.begin(), expected.end(), Equal));
+
+        for(const WMath::Vector3& center : centers)
+        {
+            std::vector<std::uint32_t> found;
+            broadphase.Radius(center, radius, found);
+            std::sort(found.begin(), found.end());
+            std::vector<std::uint32_t> expectedFound;
+            for(std::uint32_t i = 0; i < points.size(); i++)
+            {
+                if(Within(points[i], center, radius)) expectedFound.push_back(i);
+            }
+            WMATH_CHECK(found == expectedFound);
+        }
+    }
+
+    template<typename Broadphase>
+    void CheckBroadphase(Broadphase& broadphase, std::mt19937& engine, std::vector<WMath::Vector3> points, unsigned threadCount)
+    {
+        const std::vector<WMath::Vector3> centers = Tests::RandomPoints(engine, 20, -2.0f, 32.0f);
+        broadphase.Build(points, threadCount);
+        WMATH_CHECK(broadphase.Size() == points.size());
+        for(const float radius : {0.0f, 0.6f, 1.0f, 2.5f}) CheckQueries(broadphase, points, centers, radius, threadCount);
+
+        // A small jitter for every point, then a few long jumps one point at a time.
+        std::uniform_real_distribution<float> jitter(-0.3f, 0.3f);
+        for(WMath::Vector3& point : points) point += WMath::Vector3(jitter(engine), jitter(engine), jitter(engine));
+        if constexpr(std::is_same_v<Broadphase, WMath::SweepAndPrune>) broadphase.Update(points, threadCount);
+        else broadphase.Update(points);
+        CheckQueries(broadphase, points, centers, 1.0f, threadCount);
+
+        std::uniform_real_distribution<float> position(0.0f, 30.0f);
+        for(std::size_t i = 0; i < points.size(); i += 7)
+        {
+            points[i] = WMath::Vector3(position(engine), position(engine), position(engine));
+            broadphase.Update(static_cast<std::uint32_t>(i), points[i]);
+        }
+        CheckQueries(broadphase, points, centers, 1.0f, threadCount);
+    }
+}
+
+int main()
+{
+    std::mt19937 engine(21);
+    for(const std::size_t count : {std::size_t(0), std::size_t(1), std::size_t(2), std::size_t(60), std::size_t(1000), std::size_t(6000)})
+    {
+        std::vector<WMath::Vector3> points = Tests::RandomPoints(engine, count, 0.0f, 30.0f);
+        // Coincident points, far-away points that clamp to the outermost cells and negative coordinates.
+        for(std::size_t i = 0; i + 1 < points.size() && i < 20; i += 2) points[i + 1] = points[i];
+        if(points.size() > 40)
+        {
+            points[30] = WMath::Vector3(1e9f, -1e9f, 5.0f);
+            points[31] = WMath::Vector3(1e9f, -1e9f, 5.5f);
+            points[32] = WMath::Vector3(-3.0f, -0.5f, -2.0f);
+        }
+
+        for(const unsigned threadCount : {1u, 0u, 3u})
+        {
+            WMath::SpatialHash hash(1.0f);
+            CheckBroadphase(hash, engine, points, threadCount);
+            WMath::SweepAndPrune sweep;
+            CheckBroadphase(sweep, engine, points, threadCount);
+        }
+    }
+    return Tests::Finish("BroadphaseTests");
+}
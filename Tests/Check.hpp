@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "WMath/Vector3.hpp"
+
+// Minimal support for the behavior tests: each test is its own executable that reports failed checks and returns
+// nonzero from main through Tests::Finish.
+namespace Tests
+{
+    inline int failureCount = 0;
+
+    inline bool Check(bool condition, const char* expression, const char* file, int line)
+    {
+        // Only the first few failures are printed; a broken kernel tends to fail every element.
+        if(!condition && failureCount++ < 20) std::printf("%s:%d: check failed: %s\n", file, line, expression);
+        return condition;
+    }
+
+    inline int Finish(const char* name)
+    {
+        if(failureCount == 0) std::printf("%s: passed\n", name);
+        else std::printf("%s: %d checks failed\n", name, failureCount);
+        return failureCount == 0 ? 0 : 1;
+    }
+
+    inline std::vector<WMath::Vector3> RandomPoints(std::mt19937& engine, std::size_t count, float min, float max)
+    {
+        std::uniform_real_distribution<float> distribution(min, max);
+        std::vector<WMath::Vector3> points(count);
+        for(WMath::Vector3& point : points) point = {distribution(engine), distribution(engine), distribution(engine)};
+        return points;
+    }
+}
+
+#define WMATH_CHECK(condition) Tests::Check((condition), #condition, __FILE__, __LINE__)
@@ -0,0 +1,85 @@
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+#include "Check.hpp"
+#include "WMath/CounterRandom.hpp"
+
+// Checks Philox4x32-10 against the Random123 known-answer vectors and the CounterRandom fills against the per-index
+// getters, at offsets that start mid-block and spans that end mid-packet, for serial and parallel fills.
+namespace
+{
+    struct KnownAnswer
+    {
+        std::uint64_t seed;
+        std::uint64_t stream;
+        std::uint64_t index;
+        WMath::Philox4x32::Block expected;
+    };
+
+    // Random123's counter words are {index, stream} low word first and its key words are the seed, low word first.
+    constexpr KnownAnswer KnownAnswers[] = {
+        {0, 0, 0, {0x6627E8D5u, 0xE169C58Du, 0xBC57AC4Cu, 0x9B00DBD8u}},
+        {~0ull, ~0ull, ~0ull, {0x408F276Du, 0x41C83B0Eu, 0xA20BC7C6u, 0x6D5451FDu}},
+        {0x299F31D0A4093822ull, 0x0370734413198A2Eull, 0x85A308D3243F6A88ull, {0xD16CFE09u, 0x94FDCCEBu, 0x5001E420u, 0x24126EA1u}},
+    };
+
+    void CheckKnownAnswers()
+    {
+        for(const KnownAnswer& answer : KnownAnswers)
+        {
+            WMATH_CHECK(WMath::Philox4x32::Generate(answer.seed, answer.stream, answer.index) == answer.expected);
+        }
+        static_assert(WMath::Philox4x32::Generate(0, 0, 0)[0] == 0x6627E8D5u);
+    }
+
+    void CheckEngine()
+    {
+        WMath::Philox4x32 engine(42, 7);
+        for(std::uint64_t i = 0; i < 37; i++) WMATH_CHECK(engine() == WMath::Philox4x32::Get(42, 7, i));
+        engine.Discard(1000);
+        WMATH_CHECK(engine() == WMath::Philox4x32::Get(42, 7, 1037));
+    }
+
+    void CheckFills(const WMath::CounterRandom& random, std::uint64_t first, std::size_t count, unsigned threadCount)
+    {
+        std::vector<std::uint32_t> bits(count);
+        random.FillBits(first, bits, threadCount);
+        for(std::size_t i = 0; i < count; i++) WMATH_CHECK(bits[i] == random.GetBits(first + i));
+
+        std::vector<float> floats(count);
+        random.FillUniform(first, floats, -2.0f, 3.0f, threadCount);
+        for(std::size_t i = 0; i < count; i++) WMATH_CHECK(floats[i] == random.GetValue(first + i, -2.0f, 3.0f));
+
+        std::vector<int> ints(count);
+        random.FillUniform(first, ints, -5, 1000, threadCount);
+        for(std::size_t i = 0; i < count; i++) WMATH_CHECK(ints[i] == random.GetValue(first + i, -5, 1000));
+        random.FillUniform(first, ints, INT_MIN, INT_MAX, threadCount);
+        for(std::size_t i = 0; i < count; i++) WMATH_CHECK(ints[i] == random.GetValue(first + i, INT_MIN, INT_MAX));
+
+        std::vector<WMath::Vector2> vectors2(count / 2);
+        random.FillVector2(first, vectors2, 0.0f, 1.0f, threadCount);
+        for(std::size_t i = 0; i < vectors2.size(); i++) WMATH_CHECK(vectors2[i] == random.GetVector2(first + i, 0.0f, 1.0f));
+
+        std::vector<WMath::Vector3> vectors3(count / 3);
+        random.FillVector3(first, vectors3, -1.0f, 1.0f, threadCount);
+        for(std::size_t i = 0; i < vectors3.size(); i++) WMATH_CHECK(vectors3[i] == random.GetVector3(first + i, -1.0f, 1.0f));
+    }
+}
+
+int main()
+{
+    CheckKnownAnswers();
+    CheckEngine();
+
+    const WMath::CounterRandom random(0x0123456789ABCDEFull, 3);
+    WMATH_CHECK(random.WithStream(4).GetBits(0) != random.GetBits(0));
+    for(const std::uint64_t first : {0ull, 1ull, 3ull, 5ull, (1ull << 32) - 3, (1ull << 40) + 7})
+    {
+        for(const std::size_t count : {0, 1, 3, 4, 5, 63, 64, 65, 257, 1000, 70001})
+        {
+            for(const unsigned threadCount : {1u, 0u, 3u}) CheckFills(random, first, count, threadCount);
+        }
+    }
+    return Tests::Finish("CounterRandomTests");
+}
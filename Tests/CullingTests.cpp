@@ -0,0 +1,110 @@
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "Check.hpp"
+#include "WMath/Culling.hpp"
+#include "WMath/Matrix4x4.hpp"
+
+// Checks the batch sphere and box culling against Frustum::Intersects and Frustum::Contains, with and without an
+// occluder, for counts that leave partial packets and counts large enough to be culled in parallel.
+namespace
+{
+    struct Bounds
+    {
+        WMath::Vector3Array centers;
+        WMath::Vector3Array extents;
+        std::vector<float> radii;
+    };
+
+    Bounds MakeBounds(std::mt19937& engine, std::size_t count)
+    {
+        std::uniform_real_distribution<float> size(0.0f, 3.0f);
+        Bounds bounds{WMath::Vector3Array(Tests::RandomPoints(engine, count, -60.0f, 60.0f)),
+            WMath::Vector3Array(count), std::vector<float>(count)};
+        for(std::size_t i = 0; i < count; i++)
+        {
+            bounds.extents.Set(i, WMath::Vector3(size(engine), size(engine), size(engine)));
+            bounds.radii[i] = size(engine);
+        }
+        return bounds;
+    }
+
+    // Culling keeps the bounds that intersect the frustum and are not hidden behind any occluder, in index order.
+    template<typename Bound>
+    bool Visible(const WMath::Frustum& frustum, std::span<const WMath::Frustum> occluders, const Bound& bound)
+    {
+        if(!frustum.Intersects(bound)) return false;
+        for(const WMath::Frustum& occluder : occluders)
+        {
+            if(occluder.Contains(bound)) return false;
+        }
+        return true;
+    }
+
+    void CheckBounds(const WMath::Frustum& frustum, std::span<const WMath::Frustum> occluders, const Bounds& bounds,
+        unsigned threadCount)
+    {
+        const std::size_t count = bounds.radii.size();
+        std::vector<std::uint32_t> visible(count);
+        std::vector<std::uint32_t> expected;
+
+        visible.resize(WMath::Culling::Spheres(frustum, occluders, bounds.centers, bounds.radii, visible, threadCount));
+        for(std::uint32_t i = 0; i < count; i++)
+        {
+            if(Visible(frustum, occluders, WMath::Sphere(bounds.centers.Get(i), bounds.radii[i]))) expected.push_back(i);
+        }
+        WMATH_CHECK(visible == expected);
+
+        visible.resize(count);
+        expected.clear();
+        visible.resize(WMath::Culling::Boxes(frustum, occluders, bounds.centers, bounds.extents, visible, threadCount));
+        for(std::uint32_t i = 0; i < count; i++)
+        {
+            const WMath::AABB box = WMath::AABB::FromCenter(bounds.centers.Get(i), bounds.extents.Get(i));
+            if(Visible(frustum, occluders, box)) expected.push_back(i);
+        }
+        WMATH_CHECK(visible == expected);
+
+        // The overloads without occluders agree with an empty occluder list.
+        if(occluders.empty())
+        {
+            std::vector<std::uint32_t> unoccluded(count);
+            unoccluded.resize(WMath::Culling::Boxes(frustum, bounds.centers, bounds.extents, unoccluded, threadCount));
+            WMATH_CHECK(unoccluded == visible);
+            unoccluded.resize(count);
+            unoccluded.resize(WMath::Culling::Spheres(frustum, bounds.centers, bounds.radii, unoccluded, threadCount));
+            visible.resize(count);
+            visible.resize(WMath::Culling::Spheres(frustum, occluders, bounds.centers, bounds.radii, visible, threadCount));
+            WMATH_CHECK(unoccluded == visible);
+        }
+    }
+}
+
+int main()
+{
+    const WMath::Vector3 eye(1.0f, 2.0f, -30.0f);
+    const WMath::Matrix4x4 view = WMath::Matrix4x4::LookAt(eye, WMath::Vector3(0.0f, 0.0f, 0.0f), WMath::Vector3::Up());
+    const WMath::Matrix4x4 projection = WMath::Matrix4x4::Perspective(60.0f, 16.0f / 9.0f, 0.5f, 80.0f);
+    const WMath::Frustum frustum(projection * view);
+    const WMath::Frustum occluders[] = {WMath::Frustum::FromOccluder(eye, WMath::Vector3(-5.0f, -5.0f, 0.0f),
+        WMath::Vector3(5.0f, -5.0f, 0.0f), WMath::Vector3(5.0f, 5.0f, 0.0f), WMath::Vector3(-5.0f, 5.0f, 0.0f))};
+
+    // The occluder hides what is right behind its quad and nothing beside or in front of it.
+    WMATH_CHECK(occluders[0].Contains(WMath::Sphere(WMath::Vector3(0.0f, 0.0f, 10.0f), 1.0f)));
+    WMATH_CHECK(!occluders[0].Contains(WMath::Sphere(WMath::Vector3(20.0f, 0.0f, 10.0f), 1.0f)));
+    WMATH_CHECK(!occluders[0].Contains(WMath::Sphere(WMath::Vector3(0.0f, 0.0f, -10.0f), 1.0f)));
+
+    std::mt19937 engine(22);
+    for(const std::size_t count : {0, 1, 7, 16, 17, 1000, 16385, 40000})
+    {
+        const Bounds bounds = MakeBounds(engine, count);
+        for(const unsigned threadCount : {1u, 0u, 3u, 64u})
+        {
+            CheckBounds(frustum, {}, bounds, threadCount);
+            CheckBounds(frustum, occluders, bounds, threadCount);
+        }
+    }
+    return Tests::Finish("CullingTests");
+}
@@ -0,0 +1,91 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "Check.hpp"
+#include "WMath/GeometryBatch.hpp"
+
+// Checks the packet raycasts against the primitives' scalar Raycast, for every count up to a few packets so the
+// padded tail packets are covered too.
+namespace
+{
+    constexpr float Infinity = std::numeric_limits<float>::infinity();
+
+    struct Scene
+    {
+        std::vector<WMath::Ray> rays;
+        std::vector<WMath::AABB> boxes;
+        std::vector<WMath::Plane> planes;
+        std::vector<WMath::Sphere> spheres;
+        std::vector<WMath::Triangle> triangles;
+    };
+
+    Scene MakeScene(std::mt19937& engine, std::size_t count)
+    {
+        std::uniform_real_distribution<float> position(-4.0f, 4.0f);
+        std::uniform_real_distribution<float> size(0.2f, 2.0f);
+        const auto point = [&] { return WMath::Vector3(position(engine), position(engine), position(engine)); };
+
+        Scene scene;
+        for(std::size_t i = 0; i < count; i++)
+        {
+            // Rays aim into the region the primitives occupy, so a good share of them hit.
+            const WMath::Vector3 origin = point() * 2.0f;
+            WMath::Vector3 direction = point() - origin;
+            if(direction.MagnitudeSquared() < 1e-4f) direction = WMath::Vector3::Forward();
+            scene.rays.emplace_back(origin, direction);
+
+            const WMath::Vector3 center = point();
+            scene.boxes.push_back(WMath::AABB::FromCenter(center, WMath::Vector3(size(engine), size(engine), size(engine))));
+            scene.planes.emplace_back(point(), center);
+            scene.spheres.emplace_back(center, size(engine));
+            scene.triangles.emplace_back(center, center + point(), center + point());
+        }
+        // An axis-aligned ray exercises the zero direction components in the slab test.
+        if(count > 0) scene.rays[0] = WMath::Ray(WMath::Vector3(0.5f, 0.25f, -10.0f), WMath::Vector3::Forward());
+        return scene;
+    }
+
+    template<typename Primitive>
+    void CheckDistance(const Primitive& primitive, const WMath::Ray& ray, float distance)
+    {
+        float expected = 0.0f;
+        if(!primitive.Raycast(ray, expected)) expected = Infinity;
+        if(std::isinf(expected)) WMATH_CHECK(std::isinf(distance));
+        else WMATH_CHECK(std::fabs(distance - expected) <= 1e-4f * (1.0f + expected));
+    }
+
+    template<typename Primitive>
+    void CheckPrimitives(const std::vector<WMath::Ray>& rays, const std::vector<Primitive>& primitives)
+    {
+        std::vector<float> distances(rays.size());
+        if(!primitives.empty())
+        {
+            WMath::Batch::Raycast(rays, primitives.front(), distances);
+            for(std::size_t i = 0; i < rays.size(); i++) CheckDistance(primitives.front(), rays[i], distances[i]);
+        }
+
+        distances.assign(primitives.size(), 0.0f);
+        for(const WMath::Ray& ray : rays)
+        {
+            WMath::Batch::Raycast(ray, std::span<const Primitive>(primitives), distances);
+            for(std::size_t i = 0; i < primitives.size(); i++) CheckDistance(primitives[i], ray, distances[i]);
+        }
+    }
+}
+
+int main()
+{
+    std::mt19937 engine(16);
+    for(std::size_t count = 0; count <= 40; count++)
+    {
+        const Scene scene = MakeScene(engine, count);
+        CheckPrimitives(scene.rays, scene.boxes);
+        CheckPrimitives(scene.rays, scene.planes);
+        CheckPrimitives(scene.rays, scene.spheres);
+        CheckPrimitives(scene.rays, scene.triangles);
+    }
+    return Tests::Finish("GeometryBatchTests");
+}
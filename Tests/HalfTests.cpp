@@ -0,0 +1,182 @@
+#include <bit>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Check.hpp"
+#include "WMath/Half.hpp"
+
+// Checks Half and BFloat16 over every 16-bit pattern: the constant-evaluated bit operations and the runtime path (F16C
+// where available) against a straightforward reference and against each other, round trips through float, rounding of
+// the exact midpoints between neighbours to even, and the span conversions against the scalar ones.
+namespace
+{
+    using Half = WMath::Half;
+
+    // Decodes binary16 one field at a time, normalizing subnormals with a loop. NaNs come back quiet, as F16C does.
+    constexpr std::uint32_t ReferenceToFloat(std::uint32_t bits)
+    {
+        const std::uint32_t sign = (bits & 0x8000u) << 16;
+        std::uint32_t exponent = bits >> 10 & 0x1Fu;
+        std::uint32_t mantissa = bits & 0x3FFu;
+        if(exponent == 0x1Fu) return sign | 0x7F800000u | mantissa << 13 | (mantissa != 0 ? 0x00400000u : 0u);
+        if(exponent != 0) return sign | (exponent + 112) << 23 | mantissa << 13;
+        if(mantissa == 0) return sign;
+        exponent = 113;
+        while((mantissa & 0x400u) == 0)
+        {
+            mantissa <<= 1;
+            exponent--;
+        }
+        return sign | exponent << 23 | (mantissa & 0x3FFu) << 13;
+    }
+
+    constexpr bool IsNaN(std::uint32_t halfBits)
+    {
+        return (halfBits & 0x7FFFu) > 0x7C00u;
+    }
+
+    // A float that converts back to the same NaN, or to the same finite value or infinity.
+    constexpr std::uint32_t ExpectedRoundTrip(std::uint32_t halfBits)
+    {
+        return IsNaN(halfBits) ? halfBits | 0x200u : halfBits;
+    }
+
+    // The float exactly halfway between a finite half and the next one up in magnitude, and the half it must round to.
+    constexpr float Midpoint(std::uint32_t halfBits)
+    {
+        const float value = Half::FromBits(static_cast<std::uint16_t>(halfBits));
+        if((halfBits & 0x7C00u) == 0) return value + ((halfBits & 0x8000u) != 0 ? -2.98023224e-08f : 2.98023224e-08f);
+        return std::bit_cast<float>(std::bit_cast<std::uint32_t>(value) + 0x1000u);
+    }
+
+    constexpr std::uint32_t ExpectedMidpoint(std::uint32_t halfBits)
+    {
+        return (halfBits & 1u) != 0 ? halfBits + 1 : halfBits;
+    }
+
+    constexpr bool IsFinite(std::uint32_t halfBits)
+    {
+        return (halfBits & 0x7C00u) != 0x7C00u;
+    }
+
+    constexpr bool ConstantChunkMatches(std::uint32_t first)
+    {
+        for(std::uint32_t bits = first; bits < first + 256; bits++)
+        {
+            const float value = Half::FromBits(static_cast<std::uint16_t>(bits));
+            if(std::bit_cast<std::uint32_t>(value) != ReferenceToFloat(bits)) return false;
+            if(Half(value).GetBits() != ExpectedRoundTrip(bits)) return false;
+            if(IsFinite(bits) && Half(Midpoint(bits)).GetBits() != ExpectedMidpoint(bits)) return false;
+        }
+        return true;
+    }
+
+    // Each chunk is its own constant evaluation, which keeps every one well under the compilers' step limits.
+    template<std::uint32_t First>
+    constexpr bool ChunkMatches = ConstantChunkMatches(First);
+
+    template<std::size_t... Chunks>
+    constexpr bool AllChunksMatch(std::index_sequence<Chunks...>)
+    {
+        return (ChunkMatches<static_cast<std::uint32_t>(Chunks * 256)> && ...);
+    }
+
+    static_assert(AllChunksMatch(std::make_index_sequence<256>{}));
+
+    void CheckHalf(std::mt19937& engine)
+    {
+        std::vector<Half> halves(65536);
+        for(std::uint32_t bits = 0; bits < halves.size(); bits++) halves[bits] = Half::FromBits(static_cast<std::uint16_t>(bits));
+        std::vector<float> floats(halves.size());
+        WMath::ToFloat(halves, floats);
+
+        std::vector<float> values;
+        std::vector<std::uint16_t> expected;
+        for(std::uint32_t bits = 0; bits < halves.size(); bits++)
+        {
+            const float value = halves[bits];
+            WMATH_CHECK(std::bit_cast<std::uint32_t>(value) == ReferenceToFloat(bits));
+            WMATH_CHECK(std::bit_cast<std::uint32_t>(floats[bits]) == ReferenceToFloat(bits));
+            WMATH_CHECK(Half(value).GetBits() == ExpectedRoundTrip(bits));
+            values.push_back(value);
+            expected.push_back(static_cast<std::uint16_t>(ExpectedRoundTrip(bits)));
+            if(IsFinite(bits))
+            {
+                WMATH_CHECK(Half(Midpoint(bits)).GetBits() == ExpectedMidpoint(bits));
+                values.push_back(Midpoint(bits));
+                expected.push_back(static_cast<std::uint16_t>(ExpectedMidpoint(bits)));
+            }
+#if defined(WMATH_F16C)
+            WMATH_CHECK(std::bit_cast<std::uint32_t>(value) == std::bit_cast<std::uint32_t>(_cvtsh_ss(static_cast<std::uint16_t>(bits))));
+#endif
+        }
+
+        // Arbitrary float bit patterns cover overflow, underflow below the smallest subnormal and every NaN payload.
+        std::uniform_int_distribution<std::uint32_t> word;
+        for(int i = 0; i < 100000; i++)
+        {
+            const float value = std::bit_cast<float>(word(engine));
+            values.push_back(value);
+            expected.push_back(Half(value).GetBits());
+#if defined(WMATH_F16C)
+            WMATH_CHECK(Half(value).GetBits() == _cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+#endif
+        }
+
+        std::vector<Half> converted(values.size());
+        WMath::ToHalf(values, converted);
+        for(std::size_t i = 0; i < values.size(); i++) WMATH_CHECK(converted[i].GetBits() == expected[i]);
+    }
+
+    void CheckBFloat16(std::mt19937& engine)
+    {
+        std::vector<WMath::BFloat16> bfloats(65536);
+        for(std::uint32_t bits = 0; bits < bfloats.size(); bits++) bfloats[bits] = WMath::BFloat16::FromBits(static_cast<std::uint16_t>(bits));
+        std::vector<float> floats(bfloats.size());
+        WMath::ToFloat(bfloats, floats);
+
+        std::vector<float> values;
+        std::vector<std::uint16_t> expected;
+        for(std::uint32_t bits = 0; bits < bfloats.size(); bits++)
+        {
+            const float value = bfloats[bits];
+            WMATH_CHECK(std::bit_cast<std::uint32_t>(value) == bits << 16);
+            WMATH_CHECK(std::bit_cast<std::uint32_t>(floats[bits]) == bits << 16);
+            const bool isNaN = (bits & 0x7FFFu) > 0x7F80u;
+            const std::uint16_t roundTrip = static_cast<std::uint16_t>(isNaN ? bits | 0x40u : bits);
+            WMATH_CHECK(WMath::BFloat16(value).GetBits() == roundTrip);
+            values.push_back(value);
+            expected.push_back(roundTrip);
+            if((bits & 0x7FFFu) < 0x7F80u)
+            {
+                const float midpoint = std::bit_cast<float>(bits << 16 | 0x8000u);
+                const std::uint16_t rounded = static_cast<std::uint16_t>(ExpectedMidpoint(bits));
+                WMATH_CHECK(WMath::BFloat16(midpoint).GetBits() == rounded);
+                values.push_back(midpoint);
+                expected.push_back(rounded);
+            }
+        }
+
+        std::uniform_int_distribution<std::uint32_t> word;
+        for(int i = 0; i < 100000; i++)
+        {
+            const float value = std::bit_cast<float>(word(engine));
+            values.push_back(value);
+            expected.push_back(WMath::BFloat16(value).GetBits());
+        }
+
+        std::vector<WMath::BFloat16> converted(values.size());
+        WMath::ToBFloat16(values, converted);
+        for(std::size_t i = 0; i < values.size(); i++) WMATH_CHECK(converted[i].GetBits() == expected[i]);
+    }
+}
+
+int main()
+{
+    std::mt19937 engine(25);
+    CheckHalf(engine);
+    CheckBFloat16(engine);
+    return Tests::Finish("HalfTests");
+}
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Check.hpp"
+#include "WMath/KdTree.hpp"
+
+// Checks every KdTree query against a brute-force scan, for serial and parallel builds and batch queries.
+namespace
+{
+    float DistanceSquared(const WMath::Vector3& a, const WMath::Vector3& b)
+    {
+        return (a - b).MagnitudeSquared();
+    }
+
+    std::vector<float> SortedDistances(const std::vector<WMath::Vector3>& points, const WMath::Vector3& query)
+    {
+        std::vector<float> distances;
+        for(const WMath::Vector3& point : points) distances.push_back(DistanceSquared(point, query));
+        std::sort(distances.begin(), distances.end());
+        return distances;
+    }
+
+    void CheckTree(const std::vector<WMath::Vector3>& points, const std::vector<WMath::Vector3>& queries, unsigned threadCount)
+    {
+        constexpr std::size_t K = 5;
+        const WMath::KdTree tree(points, threadCount);
+        WMATH_CHECK(tree.Size() == points.size());
+
+        std::vector<std::uint32_t> nearest(queries.size());
+        std::vector<WMath::KdTree::Neighbor> kNearest(queries.size() * K);
+        tree.Nearest(queries, nearest, threadCount);
+        tree.KNearest(queries, K, kNearest, threadCount);
+
+        for(std::size_t q = 0; q < queries.size(); q++)
+        {
+            const WMath::Vector3& query = queries[q];
+            const std::vector<float> distances = SortedDistances(points, query);
+
+            // Ties may pick either point, so nearest results are compared by distance.
+            const std::uint32_t single = tree.Nearest(query);
+            if(points.empty())
+            {
+                WMATH_CHECK(single == WMath::KdTree::InvalidIndex && nearest[q] == WMath::KdTree::InvalidIndex);
+            }
+            else
+            {
+                WMATH_CHECK(single < points.size() && DistanceSquared(points[single], query) == distances[0]);
+                WMATH_CHECK(nearest[q] < points.size() && DistanceSquared(points[nearest[q]], query) == distances[0]);
+            }
+
+            for(std::size_t j = 0; j < K; j++)
+            {
+                const WMath::KdTree::Neighbor& neighbor = kNearest[q * K + j];
+                if(j < distances.size())
+                {
+                    WMATH_CHECK(neighbor.index < points.size() && neighbor.distanceSquared == distances[j]);
+                    WMATH_CHECK(neighbor.index < points.size() && DistanceSquared(points[neighbor.index], query) == neighbor.distanceSquared);
+                }
+                else WMATH_CHECK(neighbor.index == WMath::KdTree::InvalidIndex);
+            }
+
+            const float radius = 1.5f;
+            std::vector<std::uint32_t> found;
+            tree.Radius(query, radius, found);
+            std::vector<std::uint32_t> expected;
+            for(std::uint32_t i = 0; i < points.size(); i++)
+            {
+                if(DistanceSquared(points[i], query) <= radius * radius) expected.push_back(i);
+            }
+            std::sort(found.begin(), found.end());
+            WMATH_CHECK(found == expected);
+
+            const WMath::Vector3 min = query - WMath::Vector3(1.0f, 2.0f, 0.5f);
+            const WMath::Vector3 max = query + WMath::Vector3(2.0f, 0.5f, 1.0f);
+            found.clear();
+            tree.Box(min, max, found);
+            expected.clear();
+            for(std::uint32_t i = 0; i < points.size(); i++)
+            {
+                const WMath::Vector3& point = points[i];
+                if(point.x >= min.x && point.y >= min.y && point.z >= min.z && point.x <= max.x && point.y <= max.y && point.z <= max.z)
+                {
+                    expected.push_back(i);
+                }
+            }
+            std::sort(found.begin(), found.end());
+            WMATH_CHECK(found == expected);
+        }
+    }
+}
+
+int main()
+{
+    std::mt19937 engine(15);
+    const std::vector<WMath::Vector3> queries = Tests::RandomPoints(engine, 300, -12.0f, 12.0f);
+    for(const std::size_t count : {std::size_t(0), std::size_t(1), std::size_t(3), std::size_t(100), std::size_t(40000)})
+    {
+        std::vector<WMath::Vector3> points = Tests::RandomPoints(engine, count, -10.0f, 10.0f);
+        // Duplicates and points on a shared plane exercise ties and degenerate splits.
+        for(std::size_t i = 0; i + 1 < points.size() && i < 50; i += 2) points[i + 1] = points[i];
+        for(std::size_t i = 0; i < points.size() && i < 64; i++) points[i].x = 0.0f;
+
+        for(const unsigned threadCount : {1u, 0u, 3u}) CheckTree(points, queries, threadCount);
+    }
+    return Tests::Finish("KdTreeTests");
+}
@@ -0,0 +1,151 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Check.hpp"
+#include "WMath/Particles.hpp"
+
+// Checks the fused integrators against their per-particle formulas and ParticleBuffer::Compact against a serial
+// filter that keeps the surviving particles in order, for serial and parallel calls.
+namespace
+{
+    enum class Integrator
+    {
+        ExplicitEuler,
+        SemiImplicitEuler,
+        Verlet,
+        DampedSpring,
+    };
+
+    constexpr float DeltaTime = 0.1f;
+    constexpr float Stiffness = 50.0f;
+    constexpr float Damping = 2.0f;
+
+    struct Particle
+    {
+        WMath::Vector3 position;
+        WMath::Vector3 velocity;
+        WMath::Vector3 acceleration;
+        float lifetime;
+    };
+
+    void Step(Integrator integrator, Particle& particle, const WMath::Vector3& target)
+    {
+        const float dt = DeltaTime;
+        switch(integrator)
+        {
+        case Integrator::ExplicitEuler:
+            particle.position += particle.velocity * dt;
+            particle.velocity += particle.acceleration * dt;
+            break;
+        case Integrator::SemiImplicitEuler:
+            particle.velocity += particle.acceleration * dt;
+            particle.position += particle.velocity * dt;
+            break;
+        case Integrator::Verlet:
+            particle.position += particle.velocity * dt + particle.acceleration * (0.5f * dt * dt);
+            particle.velocity += particle.acceleration * dt;
+            break;
+        case Integrator::DampedSpring:
+            particle.velocity = (particle.velocity + particle.acceleration * dt + (target - particle.position) * (dt * Stiffness)) *
+                (1.0f / (1.0f + dt * Damping + dt * dt * Stiffness));
+            particle.position += particle.velocity * dt;
+            break;
+        }
+        particle.lifetime -= dt;
+    }
+
+    void Step(Integrator integrator, WMath::ParticleBuffer& particles, const WMath::Vector3Array& targets, unsigned threadCount)
+    {
+        switch(integrator)
+        {
+        case Integrator::ExplicitEuler: WMath::Integration::ExplicitEuler(particles, DeltaTime, threadCount); break;
+        case Integrator::SemiImplicitEuler: WMath::Integration::SemiImplicitEuler(particles, DeltaTime, threadCount); break;
+        case Integrator::Verlet: WMath::Integration::Verlet(particles, DeltaTime, threadCount); break;
+        case Integrator::DampedSpring:
+            WMath::Integration::DampedSpring(particles, targets, Stiffness, Damping, DeltaTime, threadCount);
+            break;
+        }
+    }
+
+    bool Near(const WMath::Vector3& a, const WMath::Vector3& b)
+    {
+        return (a - b).Magnitude() <= 1e-4f;
+    }
+
+    void CheckParticles(Integrator integrator, const std::vector<Particle>& initial, const WMath::Vector3Array& targets,
+        unsigned threadCount)
+    {
+        std::vector<Particle> expected = initial;
+        WMath::ParticleBuffer particles;
+        for(const Particle& particle : initial) particles.Add(particle.position, particle.velocity, particle.acceleration, particle.lifetime);
+
+        for(int step = 0; step < 3; step++)
+        {
+            Step(integrator, particles, targets, threadCount);
+            for(std::size_t i = 0; i < expected.size(); i++)
+            {
+                Step(integrator, expected[i], targets.Get(i));
+                WMATH_CHECK(Near(particles.positions.Get(i), expected[i].position));
+                WMATH_CHECK(Near(particles.velocities.Get(i), expected[i].velocity));
+                WMATH_CHECK(std::fabs(particles.lifetimes[i] - expected[i].lifetime) <= 1e-6f);
+            }
+        }
+
+        // Compact must move every surviving particle's streams together and keep their order.
+        std::vector<Particle> survivors;
+        for(std::size_t i = 0; i < particles.Size(); i++)
+        {
+            const Particle particle{particles.positions.Get(i), particles.velocities.Get(i), particles.accelerations.Get(i),
+                particles.lifetimes[i]};
+            if(particle.lifetime > 0.0f) survivors.push_back(particle);
+        }
+        const std::size_t count = particles.Size();
+        WMATH_CHECK(particles.Compact(threadCount) == count - survivors.size());
+        WMATH_CHECK(particles.Size() == survivors.size() && particles.lifetimes.size() == survivors.size());
+        for(std::size_t i = 0; i < survivors.size() && i < particles.Size(); i++)
+        {
+            WMATH_CHECK(particles.positions.Get(i) == survivors[i].position);
+            WMATH_CHECK(particles.velocities.Get(i) == survivors[i].velocity);
+            WMATH_CHECK(particles.accelerations.Get(i) == survivors[i].acceleration);
+            WMATH_CHECK(particles.lifetimes[i] == survivors[i].lifetime);
+        }
+    }
+}
+
+int main()
+{
+    std::mt19937 engine(23);
+    std::uniform_real_distribution<float> lifetime(0.0f, 1.0f);
+    for(const std::size_t count : {0, 1, 13, 16383, 16384, 16385, 50000})
+    {
+        const std::vector<WMath::Vector3> positions = Tests::RandomPoints(engine, count, -5.0f, 5.0f);
+        const std::vector<WMath::Vector3> velocities = Tests::RandomPoints(engine, count, -1.0f, 1.0f);
+        const std::vector<WMath::Vector3> accelerations = Tests::RandomPoints(engine, count, -1.0f, 1.0f);
+        const WMath::Vector3Array targets(Tests::RandomPoints(engine, count, -5.0f, 5.0f));
+        std::vector<Particle> initial(count);
+        for(std::size_t i = 0; i < count; i++) initial[i] = {positions[i], velocities[i], accelerations[i], lifetime(engine)};
+
+        for(const unsigned threadCount : {1u, 0u, 5u, 64u})
+        {
+            for(const Integrator integrator : {Integrator::ExplicitEuler, Integrator::SemiImplicitEuler, Integrator::Verlet,
+                Integrator::DampedSpring})
+            {
+                CheckParticles(integrator, initial, targets, threadCount);
+            }
+        }
+    }
+
+    // Verlet follows a ballistic path exactly, and the implicit spring settles on its target at any stiffness.
+    WMath::ParticleBuffer ballistic;
+    ballistic.Add(WMath::Vector3(0.0f, 0.0f, 0.0f), WMath::Vector3(1.0f, 10.0f, 0.0f), WMath::Vector3(0.0f, -9.81f, 0.0f));
+    for(int step = 0; step < 100; step++) WMath::Integration::Verlet(ballistic, 0.01f);
+    WMATH_CHECK((ballistic.positions.Get(0) - WMath::Vector3(1.0f, 10.0f - 9.81f * 0.5f, 0.0f)).Magnitude() <= 1e-3f);
+
+    WMath::ParticleBuffer spring(1);
+    const WMath::Vector3Array target(1, WMath::Vector3(1.0f, 2.0f, 3.0f));
+    for(int step = 0; step < 1000; step++) WMath::Integration::DampedSpring(spring, target, 1e6f, 10.0f, 0.1f);
+    WMATH_CHECK((spring.positions.Get(0) - WMath::Vector3(1.0f, 2.0f, 3.0f)).Magnitude() <= 1e-3f);
+    return Tests::Finish("ParticlesTests");
+}
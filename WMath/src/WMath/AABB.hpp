@@ -0,0 +1,92 @@
+﻿#pragma once
+
+#include <cassert>
+#include <limits>
+#include <span>
+#include "WMath/Ray.hpp"
+#include "WMath/Vector3.hpp"
+
+namespace WMath
+{
+    // Axis-aligned box spanning [min, max] on every axis.
+    struct AABB
+    {
+        Vector3 min;
+        Vector3 max;
+
+        constexpr AABB() = default;
+        constexpr AABB(const Vector3& min, const Vector3& max) : min(min), max(max) {}
+
+        static constexpr AABB FromCenter(const Vector3& center, const Vector3& extents)
+        {
+            return {center - extents, center + extents};
+        }
+        static AABB FromPoints(std::span<const Vector3> points)
+        {
+            assert(!points.empty());
+            AABB box(points[0], points[0]);
+            for(const Vector3& point : points.subspan(1)) box.Encapsulate(point);
+            return box;
+        }
+
+        constexpr Vector3 Center() const
+        {
+            return (min + max) * 0.5f;
+        }
+        constexpr Vector3 Extents() const
+        {
+            return (max - min) * 0.5f;
+        }
+        constexpr Vector3 Size() const
+        {
+            return max - min;
+        }
+
+        constexpr void Encapsulate(const Vector3& point)
+        {
+            min = Vector3::Min(min, point);
+            max = Vector3::Max(max, point);
+        }
+        constexpr void Encapsulate(const AABB& box)
+        {
+            min = Vector3::Min(min, box.min);
+            max = Vector3::Max(max, box.max);
+        }
+
+        constexpr bool Contains(const Vector3& point) const
+        {
+            return point.x >= min.x && point.y >= min.y && point.z >= min.z &&
+                point.x <= max.x && point.y <= max.y && point.z <= max.z;
+        }
+        constexpr bool Intersects(const AABB& other) const
+        {
+            return min.x <= other.max.x && min.y <= other.max.y && min.z <= other.max.z &&
+                other.min.x <= max.x && other.min.y <= max.y && other.min.z <= max.z;
+        }
+        constexpr Vector3 ClosestPoint(const Vector3& point) const
+        {
+            return Vector3::Min(Vector3::Max(point, min), max);
+        }
+        constexpr float DistanceSquared(const Vector3& point) const
+        {
+            return (ClosestPoint(point) - point).MagnitudeSquared();
+        }
+
+        // Slab test. A ray starting inside the box hits at distance 0.
+        bool Raycast(const Ray& ray, float& distance, float maxDistance = std::numeric_limits<float>::infinity()) const
+        {
+            const Vector3 inverseDirection = 1.0f / ray.direction;
+            const Vector3 first = (min - ray.origin) * inverseDirection;
+            const Vector3 second = (max - ray.origin) * inverseDirection;
+            const Vector3 entries = Vector3::Min(first, second);
+            const Vector3 exits = Vector3::Max(first, second);
+
+            const float enter = WMath::Max({entries.x, entries.y, entries.z, 0.0f});
+            const float exit = WMath::Min({exits.x, exits.y, exits.z, maxDistance});
+            if(enter > exit) return false;
+
+            distance = enter;
+            return true;
+        }
+    };
+}
@@ -0,0 +1,41 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace WMath
+{
+    template <typename T, std::size_t Alignment = 64>
+    class AlignedAllocator
+    {
+    public:
+        static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0);
+
+        typedef T value_type;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef AlignedAllocator<U, Alignment> other;
+        };
+
+        constexpr AlignedAllocator() noexcept = default;
+        template <typename U>
+        constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+        T* allocate(std::size_t count)
+        {
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+        }
+        void deallocate(T* pointer, std::size_t) noexcept
+        {
+            ::operator delete(pointer, std::align_val_t(Alignment));
+        }
+
+        template <typename U>
+        constexpr bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept
+        {
+            return true;
+        }
+    };
+}
@@ -0,0 +1,260 @@
+﻿#include "BatchMath.hpp"
+
+#include <cassert>
+#include <cstddef>
+
+#include "WMath/FastMath.hpp"
+#include "WMath/Simd.hpp"
+
+namespace
+{
+    typedef WMath::Simd::NativeLanes Lanes;
+    typedef Lanes::Float Float;
+
+    template<typename Kernel>
+    void Map(const float* in, float* out, std::size_t count, Kernel kernel)
+    {
+        std::size_t i = 0;
+        for(; i + Lanes::Width <= count; i += Lanes::Width) Lanes::Store(out + i, kernel(Lanes::Load(in + i)));
+        if(i == count) return;
+
+        float paddedIn[Lanes::Width] = {};
+        float paddedOut[Lanes::Width];
+        for(std::size_t lane = 0; i + lane < count; lane++) paddedIn[lane] = in[i + lane];
+        Lanes::Store(paddedOut, kernel(Lanes::Load(paddedIn)));
+        for(std::size_t lane = 0; i + lane < count; lane++) out[i + lane] = paddedOut[lane];
+    }
+
+    template<typename Kernel>
+    void Map(const float* a, const float* b, float* out, std::size_t count, Kernel kernel)
+    {
+        std::size_t i = 0;
+        for(; i + Lanes::Width <= count; i += Lanes::Width) Lanes::Store(out + i, kernel(Lanes::Load(a + i), Lanes::Load(b + i)));
+        if(i == count) return;
+
+        float paddedA[Lanes::Width] = {};
+        float paddedB[Lanes::Width] = {};
+        float paddedOut[Lanes::Width];
+        for(std::size_t lane = 0; i + lane < count; lane++)
+        {
+            paddedA[lane] = a[i + lane];
+            paddedB[lane] = b[i + lane];
+        }
+        Lanes::Store(paddedOut, kernel(Lanes::Load(paddedA), Lanes::Load(paddedB)));
+        for(std::size_t lane = 0; i + lane < count; lane++) out[i + lane] = paddedOut[lane];
+    }
+
+    template<typename Kernel>
+    void Map(std::span<const float> in, std::span<float> out, Kernel kernel)
+    {
+        assert(out.size() >= in.size());
+        Map(in.data(), out.data(), in.size(), kernel);
+    }
+
+    template<typename Kernel>
+    void Map(std::span<const float> a, std::span<const float> b, std::span<float> out, Kernel kernel)
+    {
+        assert(b.size() == a.size() && out.size() >= a.size());
+        Map(a.data(), b.data(), out.data(), a.size(), kernel);
+    }
+
+    Float Clamp(Float value, Float min, Float max)
+    {
+        return Lanes::Select(Lanes::Less(value, min), min, Lanes::Select(Lanes::Greater(value, max), max, value));
+    }
+}
+
+void WMath::Batch::Abs(std::span<const float> numbers, std::span<float> out)
+{
+    Map(numbers, out, [](Float x) { return Lanes::Abs(x); });
+}
+
+void WMath::Batch::Acos(std::span<const float> numbers, std::span<float> out)
+{
+    Map(numbers, out, [](Float x) { return Fast::Detail::Acos<Lanes>(x); });
+}
+
+void WMath::Batch::Asin(std::span<const float> numbers, std::span<float> out)
+{
+    Map(numbers, out, [](Float x)
+    {
+        Float reduced;
+        Lanes::Mask large;
+        return Fast::Detail::Asin<Lanes>(x, reduced, large);
+    });
+}
+
+void WMath::Batch::Atan(std::span<const float> numbers, std::span<float> out)
+{
+    Map(numbers, out, [](Float x) { return Fast::Detail::Atan<Lanes>(x); });
+}
+
+void WMath::Batch::Atan2(std::span<const float> y, std::span<const float> x, std::span<float> out)
+{
+    Map(y, x, out, [](Float a, Float b) { return Fast::Detail::Atan2<Lanes>(a, b); });
+}
+
+void WMath::Batch::Ceil(std::span<const float> numbers, std::span<float> out)
+{
+    Map(numbers, out, [](Float x)
+    {
+        const Float negativeZero = Lanes::Set(-0.0f);
+        return Lanes::Sub(negativeZero, Lanes::Floor(Lanes::Sub(negativeZero, x)));
+    });
+}
+
+void WMath::Batch::Clamp(std::span<const float> values, float min, float max, std::span<float> out)
+{
+    const Float minimum = Lanes::Set(min);
+    const Float maximum = Lanes::Set(max);
+    Map(values, out, [&](Float x) { return ::Clamp(x, minimum, maximum); });
+}
+
+void WMath::Batch::Clamp01(std::span<const float> values, std::span<float> out)
+{
+    Clamp(values, 0.0f, 1.0f, out);
+}
+
+void WMath::Batch::Cos(std::span<const float> numbers, std::span<float> out)
+{
+    Map(numbers, out, [](Float x)
+    {
+        Float sin, cos;
+        Fast::Detail::SinCos<Lanes>(x, sin, cos);
+        return cos;
+    });
+}
+
+void WMath::Batch::Exp(std::span<const float> numbers, std::span<float> out)
+{
+    Map(numbers, out, [](Float x) { return Fast::Detail::Exp<Lanes>(x); });
+}
+
+void WMath::Batch::Floor(std::span<const float> numbers, std::span<float> out)
+{
+    Map(numbers, out, [](Float x) { return Lanes::Floor(x); });
+}
+
+void WMath::Batch::InvLerp(float start, float end, std::span<const float> values, std::span<float> out)
+{
+    const Float startLanes = Lanes::Set(start);
+    const Float range = Lanes::Set(end - start);
+    Map(values, out, [&](Float x) { return Lanes::Div(Lanes::Sub(x, startLanes), range); });
+}
+
+void WMath::Batch::InvSqrt(std::span<const float> numbers, std::span<float> out)
+{
+    Map(numbers, out, [](Float x) { return Fast::Detail::InvSqrt<Lanes>(x); });
+}
+
+void WMath::Batch::Lerp(float start, float end, std::span<const float> values, std::span<float> out)
+{
+    const Float startLanes = Lanes::Set(start);
+    const Float range = Lanes::Set(end - start);
+    Map(values, out, [&](Float x) { return Lanes::Add(startLanes, Lanes::Mul(range, x)); });
+}
+
+void WMath::Batch::Ln(std::span<const float> numbers, std::span<float> out)
+{
+    Map(numbers, out, [](Float x) { return Fast::Detail::Ln<Lanes>(x); });
+}
+
+void WMath::Batch::Log(std::span<const float> numbers, float base, std::span<float> out)
+{
+    const Float inverseLnBase = Lanes::Set(1.0f / Fast::Ln(base));
+    Map(numbers, out, [&](Float x) { return Lanes::Mul(Fast::Detail::Ln<Lanes>(x), inverseLnBase); });
+}
+
+void WMath::Batch::Log10(std::span<const float> numbers, std::span<float> out)
+{
+    Map(numbers, out, [](Float x) { return Lanes::Mul(Fast::Detail::Ln<Lanes>(x), Lanes::Set(0.434294481903251828f)); });
+}
+
+void WMath::Batch::Pow(std::span<const float> numbers, float power, std::span<float> out)
+{
+    const Float powerLanes = Lanes::Set(power);
+    Map(numbers, out, [&](Float x) { return Fast::Detail::Pow<Lanes>(x, powerLanes); });
+}
+
+void WMath::Batch::Pow(std::span<const float> numbers, std::span<const float> powers, std::span<float> out)
+{
+    Map(numbers, powers, out, [](Float x, Float power) { return Fast::Detail::Pow<Lanes>(x, power); });
+}
+
+void WMath::Batch::Round(std::span<const float> numbers, std::span<float> out)
+{
+    Map(numbers, out, [](Float x)
+    {
+        const Float magnitude = Lanes::Abs(x);
+        const Float floor = Lanes::Floor(magnitude);
+        const Lanes::Mask roundUp = Lanes::LessEqual(Lanes::Set(0.5f), Lanes::Sub(magnitude, floor));
+        const Float rounded = Lanes::Add(floor, Lanes::Select(roundUp, Lanes::Set(1.0f), Lanes::Set(0.0f)));
+        return Fast::Detail::CopySign<Lanes>(rounded, x);
+    });
+}
+
+void WMath::Batch::Sin(std::span<const float> numbers, std::span<float> out)
+{
+    Map(numbers, out, [](Float x)
+    {
+        Float sin, cos;
+        Fast::Detail::SinCos<Lanes>(x, sin, cos);
+        return sin;
+    });
+}
+
+void WMath::Batch::SinCos(std::span<const float> numbers, std::span<float> sin, std::span<float> cos)
+{
+    assert(sin.size() >= numbers.size() && cos.size() >= numbers.size());
+
+    const std::size_t count = numbers.size();
+    std::size_t i = 0;
+    for(; i + Lanes::Width <= count; i += Lanes::Width)
+    {
+        Float sinLanes, cosLanes;
+        Fast::Detail::SinCos<Lanes>(Lanes::Load(numbers.data() + i), sinLanes, cosLanes);
+        Lanes::Store(sin.data() + i, sinLanes);
+        Lanes::Store(cos.data() + i, cosLanes);
+    }
+    if(i == count) return;
+
+    float paddedIn[Lanes::Width] = {};
+    float paddedSin[Lanes::Width];
+    float paddedCos[Lanes::Width];
+    for(std::size_t lane = 0; i + lane < count; lane++) paddedIn[lane] = numbers[i + lane];
+    Float sinLanes, cosLanes;
+    Fast::Detail::SinCos<Lanes>(Lanes::Load(paddedIn), sinLanes, cosLanes);
+    Lanes::Store(paddedSin, sinLanes);
+    Lanes::Store(paddedCos, cosLanes);
+    for(std::size_t lane = 0; i + lane < count; lane++)
+    {
+        sin[i + lane] = paddedSin[lane];
+        cos[i + lane] = paddedCos[lane];
+    }
+}
+
+void WMath::Batch::SmoothStep(float start, float end, std::span<const float> values, std::span<float> out)
+{
+    const Float startLanes = Lanes::Set(start);
+    const Float range = Lanes::Set(end - start);
+    Map(values, out, [&](Float value)
+    {
+        const Float x = ::Clamp(Lanes::Div(Lanes::Sub(value, startLanes), range), Lanes::Set(0.0f), Lanes::Set(1.0f));
+        return Lanes::Mul(Lanes::Mul(x, x), Lanes::Sub(Lanes::Set(3.0f), Lanes::Mul(Lanes::Set(2.0f), x)));
+    });
+}
+
+void WMath::Batch::Sqrt(std::span<const float> numbers, std::span<float> out)
+{
+    Map(numbers, out, [](Float x) { return Lanes::Sqrt(x); });
+}
+
+void WMath::Batch::Tan(std::span<const float> numbers, std::span<float> out)
+{
+    Map(numbers, out, [](Float x)
+    {
+        Float sin, cos;
+        Fast::Detail::SinCos<Lanes>(x, sin, cos);
+        return Lanes::Div(sin, cos);
+    });
+}
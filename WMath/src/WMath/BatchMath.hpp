@@ -0,0 +1,39 @@
+﻿#pragma once
+
+#include <span>
+
+namespace WMath::Batch
+{
+    // Span versions of the Utils functions, evaluated Simd::NativeLanes (1, 4, 8 or 16) values at a time. A trailing
+    // partial block is padded, so every element goes through the same code path. Outputs may alias the inputs.
+    //
+    // Abs, Ceil, Clamp, Clamp01, Floor, InvLerp, Lerp, Round, SmoothStep and Sqrt match the scalar Utils functions.
+    // The transcendental functions use the WMath::Fast kernels and stay within the error bounds documented in
+    // FastMath.hpp relative to the scalar Utils functions.
+
+    void Abs(std::span<const float> numbers, std::span<float> out);
+    void Acos(std::span<const float> numbers, std::span<float> out);
+    void Asin(std::span<const float> numbers, std::span<float> out);
+    void Atan(std::span<const float> numbers, std::span<float> out);
+    void Atan2(std::span<const float> y, std::span<const float> x, std::span<float> out);
+    void Ceil(std::span<const float> numbers, std::span<float> out);
+    void Clamp(std::span<const float> values, float min, float max, std::span<float> out);
+    void Clamp01(std::span<const float> values, std::span<float> out);
+    void Cos(std::span<const float> numbers, std::span<float> out);
+    void Exp(std::span<const float> numbers, std::span<float> out);
+    void Floor(std::span<const float> numbers, std::span<float> out);
+    void InvLerp(float start, float end, std::span<const float> values, std::span<float> out);
+    void InvSqrt(std::span<const float> numbers, std::span<float> out);
+    void Lerp(float start, float end, std::span<const float> values, std::span<float> out);
+    void Ln(std::span<const float> numbers, std::span<float> out);
+    void Log(std::span<const float> numbers, float base, std::span<float> out);
+    void Log10(std::span<const float> numbers, std::span<float> out);
+    void Pow(std::span<const float> numbers, float power, std::span<float> out);
+    void Pow(std::span<const float> numbers, std::span<const float> powers, std::span<float> out);
+    void Round(std::span<const float> numbers, std::span<float> out);
+    void Sin(std::span<const float> numbers, std::span<float> out);
+    void SinCos(std::span<const float> numbers, std::span<float> sin, std::span<float> cos);
+    void SmoothStep(float start, float end, std::span<const float> values, std::span<float> out);
+    void Sqrt(std::span<const float> numbers, std::span<float> out);
+    void Tan(std::span<const float> numbers, std::span<float> out);
+}
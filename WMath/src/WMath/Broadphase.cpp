@@ -0,0 +1,440 @@
+﻿#include "Broadphase.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+#include "WMath/Parallel.hpp"
+
+namespace
+{
+    constexpr std::size_t ParallelGrainSize = 4096;
+    constexpr int CellBits = 21;
+    // Insertion sort in SweepAndPrune::Update gives up for a full sort after this many moves per point.
+    constexpr std::size_t MaxMovesPerPoint = 8;
+    constexpr int RadixBits = 11;
+    constexpr int RadixPasses = 3;
+
+    // Runs function(begin, end, pairs) over chunks of [0, count), each appending to its own buffer, and concatenates
+    // the buffers in chunk order.
+    template<typename Function>
+    void CollectPairs(std::size_t count, unsigned threadCount, std::vector<std::vector<WMath::IndexPair>>& chunks,
+        std::vector<WMath::IndexPair>& out, const Function& function)
+    {
+        out.clear();
+        if(threadCount == 1 || count <= ParallelGrainSize)
+        {
+            function(std::size_t(0), count, out);
+            return;
+        }
+
+        const std::size_t chunkCount = std::min(count / ParallelGrainSize + 1, WMath::Parallel::ChunkCount(threadCount));
+        if(chunks.size() < chunkCount) chunks.resize(chunkCount);
+        WMath::ThreadPool::Global().For(chunkCount, 1, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t chunk = begin; chunk < end; chunk++)
+            {
+                chunks[chunk].clear();
+                function(chunk * count / chunkCount, (chunk + 1) * count / chunkCount, chunks[chunk]);
+            }
+        });
+
+        std::size_t total = 0;
+        for(std::size_t chunk = 0; chunk < chunkCount; chunk++) total += chunks[chunk].size();
+        out.reserve(total);
+        for(std::size_t chunk = 0; chunk < chunkCount; chunk++) out.insert(out.end(), chunks[chunk].begin(), chunks[chunk].end());
+    }
+
+    WMath::IndexPair MakePair(std::uint32_t a, std::uint32_t b)
+    {
+        return a < b ? WMath::IndexPair{a, b} : WMath::IndexPair{b, a};
+    }
+
+    float Component(const WMath::Vector3& vector, int axis)
+    {
+        return axis == 0 ? vector.x : axis == 1 ? vector.y : vector.z;
+    }
+
+    int CellCoordinate(float coordinate, float inverseCellSize)
+    {
+        // Clamping keeps far-away points well defined; they just share the outermost cells.
+        constexpr float limit = 1 << (CellBits - 1);
+        return static_cast<int>(std::floor(std::clamp(coordinate * inverseCellSize, -limit, limit - 1)));
+    }
+
+    std::uint64_t PackCell(int x, int y, int z)
+    {
+        constexpr std::uint64_t cellMask = (std::uint64_t(1) << CellBits) - 1;
+        return (static_cast<std::uint64_t>(x) & cellMask) | (static_cast<std::uint64_t>(y) & cellMask) << CellBits |
+            (static_cast<std::uint64_t>(z) & cellMask) << 2 * CellBits;
+    }
+
+    // Maps floats to unsigned integers with the same order, for radix sorting.
+    std::uint32_t SortKey(float value)
+    {
+        const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+        return bits ^ ((bits >> 31) != 0 ? 0xFFFFFFFFu : 0x80000000u);
+    }
+}
+
+WMath::SpatialHash::SpatialHash(float cellSize)
+{
+    SetCellSize(cellSize);
+}
+
+void WMath::SpatialHash::SetCellSize(float newCellSize)
+{
+    assert(newCellSize > 0);
+    cellSize = newCellSize;
+    inverseCellSize = 1.0f / newCellSize;
+}
+
+void WMath::SpatialHash::Build(std::span<const Vector3> points, unsigned threadCount)
+{
+    assert(points.size() < InvalidIndex);
+    const std::uint32_t count = static_cast<std::uint32_t>(points.size());
+    const std::uint32_t tableSize = std::bit_ceil(std::max<std::uint32_t>(16, 2 * count));
+    mask = tableSize - 1;
+
+    // A counting sort by bucket; next holds each point's bucket until the slots are laid out.
+    next.resize(count);
+    Parallel::For(count, threadCount, [&](std::size_t begin, std::size_t end)
+    {
+        for(std::size_t i = begin; i < end; i++) next[i] = Bucket(Cell(points[i]));
+    }, ParallelGrainSize);
+
+    heads.assign(tableSize, 0);
+    for(std::uint32_t i = 0; i < count; i++) heads[next[i]]++;
+    std::uint32_t start = 0;
+    for(std::uint32_t& head : heads) start += std::exchange(head, start);
+    indices.resize(count);
+    for(std::uint32_t i = 0; i < count; i++) indices[heads[next[i]]++] = i;
+
+    // Only the scatter above runs serially; the slot contents and the chains are filled in parallel from it.
+    positions.resize(count);
+    slots.resize(count);
+    cells.resize(count);
+    buckets.resize(count);
+    Parallel::For(count, threadCount, [&](std::size_t begin, std::size_t end)
+    {
+        for(std::size_t slot = begin; slot < end; slot++)
+        {
+            const std::uint32_t index = indices[slot];
+            positions[slot] = points[index];
+            slots[index] = static_cast<std::uint32_t>(slot);
+            cells[slot] = Cell(points[index]);
+            buckets[slot] = Bucket(cells[slot]);
+        }
+    }, ParallelGrainSize);
+
+    std::fill(heads.begin(), heads.end(), InvalidIndex);
+    Parallel::For(count, threadCount, [&](std::size_t begin, std::size_t end)
+    {
+        for(std::size_t slot = begin; slot < end; slot++)
+        {
+            const std::uint32_t bucket = buckets[slot];
+            if(slot == 0 || buckets[slot - 1] != bucket) heads[bucket] = static_cast<std::uint32_t>(slot);
+            next[slot] = slot + 1 < count && buckets[slot + 1] == bucket ? static_cast<std::uint32_t>(slot + 1) : InvalidIndex;
+        }
+    }, ParallelGrainSize);
+}
+
+void WMath::SpatialHash::Clear()
+{
+    heads.clear();
+    next.clear();
+    buckets.clear();
+    cells.clear();
+    positions.clear();
+    indices.clear();
+    slots.clear();
+    mask = 0;
+}
+
+void WMath::SpatialHash::Update(std::uint32_t index, const Vector3& position)
+{
+    const std::uint32_t slot = slots[index];
+    positions[slot] = position;
+    const std::uint64_t cell = Cell(position);
+    if(cell == cells[slot]) return;
+    cells[slot] = cell;
+    const std::uint32_t bucket = Bucket(cell);
+    if(bucket != buckets[slot]) Relink(slot, bucket);
+}
+
+void WMath::SpatialHash::Update(std::span<const Vector3> points)
+{
+    assert(points.size() == Size());
+    for(std::uint32_t i = 0; i < points.size(); i++) Update(i, points[i]);
+}
+
+void WMath::SpatialHash::Radius(const Vector3& center, float radius, std::vector<std::uint32_t>& out) const
+{
+    const float radiusSquared = radius * radius;
+    ForEachCandidate(center, radius, [&](std::uint32_t slot)
+    {
+        if((positions[slot] - center).MagnitudeSquared() <= radiusSquared) out.push_back(indices[slot]);
+    });
+}
+
+void WMath::SpatialHash::FindPairs(float radius, std::vector<IndexPair>& out, unsigned threadCount) const
+{
+    const float radiusSquared = radius * radius;
+    // Once a point sees more cells than there are points, comparing every pair is cheaper than walking the cells.
+    const std::int64_t reach = CellCoordinate(radius, inverseCellSize) + 1;
+    if((2 * reach + 1) * (2 * reach + 1) * (2 * reach + 1) > static_cast<std::int64_t>(positions.size()))
+    {
+        CollectPairs(Size(), threadCount, chunkPairs, out, [&](std::size_t begin, std::size_t end, std::vector<IndexPair>& pairs)
+        {
+            for(std::size_t slot = begin; slot < end; slot++)
+            {
+                for(std::size_t other = slot + 1; other < positions.size(); other++)
+                {
+                    if((positions[other] - positions[slot]).MagnitudeSquared() <= radiusSquared) pairs.push_back(MakePair(indices[slot], indices[other]));
+                }
+            }
+        });
+        return;
+    }
+
+    // Each pair of cells is visited from one side only: the cells after the own one in z, y, x order, plus the own
+    // cell with the slots after this one.
+    CollectPairs(Size(), threadCount, chunkPairs, out, [&](std::size_t begin, std::size_t end, std::vector<IndexPair>& pairs)
+    {
+        for(std::size_t slot = begin; slot < end; slot++)
+        {
+            const Vector3& position = positions[slot];
+            const int cellX = CellCoordinate(position.x, inverseCellSize);
+            const int cellY = CellCoordinate(position.y, inverseCellSize);
+            const int cellZ = CellCoordinate(position.z, inverseCellSize);
+            const int minX = CellCoordinate(position.x - radius, inverseCellSize), maxX = CellCoordinate(position.x + radius, inverseCellSize);
+            const int minY = CellCoordinate(position.y - radius, inverseCellSize), maxY = CellCoordinate(position.y + radius, inverseCellSize);
+            const int maxZ = CellCoordinate(position.z + radius, inverseCellSize);
+            for(int z = cellZ; z <= maxZ; z++)
+            {
+                for(int y = z == cellZ ? cellY : minY; y <= maxY; y++)
+                {
+                    for(int x = z == cellZ && y == cellY ? cellX : minX; x <= maxX; x++)
+                    {
+                        const std::uint64_t cell = PackCell(x, y, z);
+                        const bool ownCell = cell == cells[slot];
+                        for(std::uint32_t other = heads[Bucket(cell)]; other != InvalidIndex; other = next[other])
+                        {
+                            if(cells[other] != cell || (ownCell && other <= slot)) continue;
+                            if((positions[other] - position).MagnitudeSquared() <= radiusSquared) pairs.push_back(MakePair(indices[slot], indices[other]));
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+std::uint64_t WMath::SpatialHash::Cell(const Vector3& position) const
+{
+    return PackCell(CellCoordinate(position.x, inverseCellSize), CellCoordinate(position.y, inverseCellSize),
+        CellCoordinate(position.z, inverseCellSize));
+}
+
+std::uint32_t WMath::SpatialHash::Bucket(std::uint64_t cell) const
+{
+    // z sits in the high bits of the packed cell, so they need folding down before the multiply.
+    std::uint64_t hash = (cell ^ cell >> 29) * 0xBF58476D1CE4E5B9u;
+    return static_cast<std::uint32_t>(hash ^ hash >> 32) & mask;
+}
+
+void WMath::SpatialHash::Relink(std::uint32_t slot, std::uint32_t bucket)
+{
+    const std::uint32_t previousBucket = buckets[slot];
+    if(heads[previousBucket] == slot) heads[previousBucket] = next[slot];
+    else
+    {
+        std::uint32_t previous = heads[previousBucket];
+        while(next[previous] != slot) previous = next[previous];
+        next[previous] = next[slot];
+    }
+
+    next[slot] = heads[bucket];
+    heads[bucket] = slot;
+    buckets[slot] = bucket;
+}
+
+template<typename Function>
+void WMath::SpatialHash::ForEachCandidate(const Vector3& center, float radius, const Function& function) const
+{
+    if(Empty()) return;
+
+    const int minX = CellCoordinate(center.x - radius, inverseCellSize), maxX = CellCoordinate(center.x + radius, inverseCellSize);
+    const int minY = CellCoordinate(center.y - radius, inverseCellSize), maxY = CellCoordinate(center.y + radius, inverseCellSize);
+    const int minZ = CellCoordinate(center.z - radius, inverseCellSize), maxZ = CellCoordinate(center.z + radius, inverseCellSize);
+    const std::int64_t cellCount = (static_cast<std::int64_t>(maxX) - minX + 1) * (static_cast<std::int64_t>(maxY) - minY + 1) *
+        (static_cast<std::int64_t>(maxZ) - minZ + 1);
+    if(cellCount > static_cast<std::int64_t>(positions.size()))
+    {
+        for(std::uint32_t slot = 0; slot < positions.size(); slot++) function(slot);
+        return;
+    }
+
+    // Distinct cells can share a bucket, so each walk keeps only the slots of its own cell.
+    for(int z = minZ; z <= maxZ; z++)
+    {
+        for(int y = minY; y <= maxY; y++)
+        {
+            for(int x = minX; x <= maxX; x++)
+            {
+                const std::uint64_t cell = PackCell(x, y, z);
+                for(std::uint32_t slot = heads[Bucket(cell)]; slot != InvalidIndex; slot = next[slot])
+                {
+                    if(cells[slot] == cell) function(slot);
+                }
+            }
+        }
+    }
+}
+
+void WMath::SweepAndPrune::Build(std::span<const Vector3> points, unsigned threadCount)
+{
+    assert(points.size() < SpatialHash::InvalidIndex);
+    const std::uint32_t count = static_cast<std::uint32_t>(points.size());
+    entries.resize(count);
+    if(count == 0) return;
+
+    Vector3 min = points[0];
+    Vector3 max = min;
+    for(std::uint32_t i = 0; i < count; i++)
+    {
+        entries[i] = {points[i], i};
+        min = Vector3::Min(min, points[i]);
+        max = Vector3::Max(max, points[i]);
+    }
+    const Vector3 extent = max - min;
+    axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : extent.y >= extent.z ? 1 : 2;
+
+    Sort(threadCount);
+}
+
+void WMath::SweepAndPrune::Clear()
+{
+    entries.clear();
+    scratch.clear();
+    ranks.clear();
+}
+
+void WMath::SweepAndPrune::Update(std::uint32_t index, const Vector3& position)
+{
+    const std::uint32_t rank = ranks[index];
+    entries[rank].position = position;
+    MoveToRank(rank);
+}
+
+void WMath::SweepAndPrune::Update(std::span<const Vector3> points, unsigned threadCount)
+{
+    assert(points.size() == Size());
+    Parallel::For(entries.size(), threadCount, [&](std::size_t begin, std::size_t end)
+    {
+        for(std::size_t rank = begin; rank < end; rank++) entries[rank].position = points[entries[rank].index];
+    }, ParallelGrainSize);
+
+    // Insertion sort, falling back to a full sort when the points moved too far for it to stay near linear.
+    const std::size_t maxMoves = MaxMovesPerPoint * entries.size();
+    std::size_t moves = 0;
+    for(std::size_t i = 1; i < entries.size() && moves <= maxMoves; i++)
+    {
+        const Entry entry = entries[i];
+        const float key = Key(entry);
+        std::size_t j = i;
+        for(; j > 0 && Key(entries[j - 1]) > key; j--) entries[j] = entries[j - 1];
+        entries[j] = entry;
+        moves += i - j;
+    }
+    if(moves > maxMoves)
+    {
+        Sort(threadCount);
+        return;
+    }
+
+    Parallel::For(entries.size(), threadCount, [&](std::size_t begin, std::size_t end)
+    {
+        for(std::size_t rank = begin; rank < end; rank++) ranks[entries[rank].index] = static_cast<std::uint32_t>(rank);
+    }, ParallelGrainSize);
+}
+
+void WMath::SweepAndPrune::Radius(const Vector3& center, float radius, std::vector<std::uint32_t>& out) const
+{
+    const float radiusSquared = radius * radius;
+    const float first = Component(center, axis) - radius;
+    const float last = Component(center, axis) + radius;
+    auto entry = std::partition_point(entries.begin(), entries.end(), [&](const Entry& entry) { return Key(entry) < first; });
+    for(; entry != entries.end() && Key(*entry) <= last; ++entry)
+    {
+        if((entry->position - center).MagnitudeSquared() <= radiusSquared) out.push_back(entry->index);
+    }
+}
+
+void WMath::SweepAndPrune::FindPairs(float radius, std::vector<IndexPair>& out, unsigned threadCount) const
+{
+    const float radiusSquared = radius * radius;
+    CollectPairs(Size(), threadCount, chunkPairs, out, [&](std::size_t begin, std::size_t end, std::vector<IndexPair>& pairs)
+    {
+        for(std::size_t i = begin; i < end; i++)
+        {
+            const Entry& entry = entries[i];
+            const float last = Key(entry) + radius;
+            for(std::size_t j = i + 1; j < entries.size() && Key(entries[j]) <= last; j++)
+            {
+                if((entries[j].position - entry.position).MagnitudeSquared() <= radiusSquared) pairs.push_back(MakePair(entry.index, entries[j].index));
+            }
+        }
+    });
+}
+
+void WMath::SweepAndPrune::Sort(unsigned threadCount)
+{
+    // LSD radix sort on the order-preserving bit pattern of the key, three passes of 11 bits.
+    const std::size_t count = entries.size();
+    scratch.resize(count);
+    std::uint32_t histograms[RadixPasses][1 << RadixBits] = {};
+    for(const Entry& entry : entries)
+    {
+        const std::uint32_t key = SortKey(Key(entry));
+        for(int pass = 0; pass < RadixPasses; pass++) histograms[pass][key >> (pass * RadixBits) & ((1u << RadixBits) - 1)]++;
+    }
+
+    for(int pass = 0; pass < RadixPasses; pass++)
+    {
+        std::uint32_t start = 0;
+        for(std::uint32_t& bin : histograms[pass]) start += std::exchange(bin, start);
+        for(const Entry& entry : entries)
+        {
+            const std::uint32_t digit = SortKey(Key(entry)) >> (pass * RadixBits) & ((1u << RadixBits) - 1);
+            scratch[histograms[pass][digit]++] = entry;
+        }
+        entries.swap(scratch);
+    }
+
+    ranks.resize(count);
+    Parallel::For(count, threadCount, [&](std::size_t begin, std::size_t end)
+    {
+        for(std::size_t rank = begin; rank < end; rank++) ranks[entries[rank].index] = static_cast<std::uint32_t>(rank);
+    }, ParallelGrainSize);
+}
+
+void WMath::SweepAndPrune::MoveToRank(std::uint32_t rank)
+{
+    const Entry entry = entries[rank];
+    const float key = Key(entry);
+    for(; rank > 0 && Key(entries[rank - 1]) > key; rank--)
+    {
+        entries[rank] = entries[rank - 1];
+        ranks[entries[rank].index] = rank;
+    }
+    for(; rank + 1 < entries.size() && Key(entries[rank + 1]) < key; rank++)
+    {
+        entries[rank] = entries[rank + 1];
+        ranks[entries[rank].index] = rank;
+    }
+    entries[rank] = entry;
+    ranks[entry.index] = rank;
+}
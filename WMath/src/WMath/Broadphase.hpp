@@ -0,0 +1,134 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include "WMath/Vector3.hpp"
+
+namespace WMath
+{
+    // Two point indices with first < second.
+    struct IndexPair
+    {
+        std::uint32_t first;
+        std::uint32_t second;
+    };
+
+    // Broadphases over a set of moving points. Build takes the points once, Update moves them without a rebuild, and
+    // the queries report indices into the span given to Build. Buffers are kept between builds and queries, so a
+    // steady-state tick allocates nothing. A threadCount other than 1 runs on ThreadPool::Global(), with 0 letting the
+    // pool balance the work freely; pair lists come out in no particular order. Radius queries may run concurrently
+    // with each other; FindPairs reuses per-chunk buffers, so FindPairs calls on one broadphase must not overlap.
+
+    // Uniform grid hashed into a table of linked buckets. Build lays every bucket out contiguously; Update relinks a
+    // moved point in constant time, at some cost in locality until the next Build. Best when the query radius is close
+    // to the cell size.
+    class SpatialHash
+    {
+    public:
+        static constexpr std::uint32_t InvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+        explicit SpatialHash(float cellSize = 1.0f);
+
+        float GetCellSize() const
+        {
+            return cellSize;
+        }
+        // Takes effect at the next Build.
+        void SetCellSize(float newCellSize);
+
+        void Build(std::span<const Vector3> points, unsigned threadCount = 1);
+        void Clear();
+
+        std::size_t Size() const
+        {
+            return positions.size();
+        }
+        bool Empty() const
+        {
+            return positions.empty();
+        }
+
+        void Update(std::uint32_t index, const Vector3& position);
+        // Moves every point; points must have the size of the built set.
+        void Update(std::span<const Vector3> points);
+
+        // Appends the indices within radius of center.
+        void Radius(const Vector3& center, float radius, std::vector<std::uint32_t>& out) const;
+        // Replaces out with every pair of points at most radius apart.
+        void FindPairs(float radius, std::vector<IndexPair>& out, unsigned threadCount = 1) const;
+
+    private:
+        float cellSize;
+        float inverseCellSize;
+        std::uint32_t mask = 0;
+
+        // Bucket heads index slots; a slot holds one point, and slots of a bucket are chained through next. Cells
+        // sharing a bucket are told apart by the packed cell coordinates of each slot.
+        std::vector<std::uint32_t> heads;
+        std::vector<std::uint32_t> next;
+        std::vector<std::uint32_t> buckets;
+        std::vector<std::uint64_t> cells;
+        std::vector<Vector3> positions;
+        std::vector<std::uint32_t> indices;
+        std::vector<std::uint32_t> slots;
+        mutable std::vector<std::vector<IndexPair>> chunkPairs;
+
+        std::uint64_t Cell(const Vector3& position) const;
+        std::uint32_t Bucket(std::uint64_t cell) const;
+        void Relink(std::uint32_t slot, std::uint32_t bucket);
+        template<typename Function>
+        void ForEachCandidate(const Vector3& center, float radius, const Function& function) const;
+    };
+
+    // Points sorted along the axis with the widest spread at Build. Update keeps the order with insertion sort, which
+    // is close to linear under the small per-tick motion it is meant for. Needs no tuning, but degrades when many
+    // points share a coordinate range on the sort axis.
+    class SweepAndPrune
+    {
+    public:
+        void Build(std::span<const Vector3> points, unsigned threadCount = 1);
+        void Clear();
+
+        std::size_t Size() const
+        {
+            return entries.size();
+        }
+        bool Empty() const
+        {
+            return entries.empty();
+        }
+        int GetAxis() const
+        {
+            return axis;
+        }
+
+        void Update(std::uint32_t index, const Vector3& position);
+        // Moves every point; points must have the size of the built set.
+        void Update(std::span<const Vector3> points, unsigned threadCount = 1);
+
+        void Radius(const Vector3& center, float radius, std::vector<std::uint32_t>& out) const;
+        void FindPairs(float radius, std::vector<IndexPair>& out, unsigned threadCount = 1) const;
+
+    private:
+        struct Entry
+        {
+            Vector3 position;
+            std::uint32_t index;
+        };
+
+        int axis = 0;
+        std::vector<Entry> entries;
+        std::vector<Entry> scratch;
+        std::vector<std::uint32_t> ranks;
+        mutable std::vector<std::vector<IndexPair>> chunkPairs;
+
+        float Key(const Entry& entry) const
+        {
+            return axis == 0 ? entry.position.x : axis == 1 ? entry.position.y : entry.position.z;
+        }
+        void Sort(unsigned threadCount);
+        void MoveToRank(std::uint32_t rank);
+    };
+}
@@ -0,0 +1,285 @@
+﻿#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+namespace WMath::Constexpr
+{
+    // Double-precision math usable in constant expressions, behind the compile-time path of the Utils functions. The
+    // results are within a few double ulps, so float results round to the libm value or one ulp next to it. Sin, Cos and
+    // Tan reduce their argument with a three-part pi / 2 and stay that accurate for |number| below about 1e9.
+
+    namespace Detail
+    {
+        constexpr double Infinity = std::numeric_limits<double>::infinity();
+        constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+        constexpr double PI = 3.14159265358979323846;
+        constexpr double HalfPI = 1.57079632679489661923;
+        constexpr double Ln2High = 6.93147180369123816490e-01;
+        constexpr double Ln2Low = 1.90821492927058770002e-10;
+        constexpr double HalfPI1 = 1.57079632673412561417e+00;
+        constexpr double HalfPI2 = 6.07710050630396597660e-11;
+        constexpr double HalfPI3 = 2.02226624871116645580e-21;
+        constexpr double HalfPI3Tail = 8.47842766036889956997e-32;
+
+        constexpr bool IsNaN(double number)
+        {
+            return number != number;
+        }
+
+        constexpr bool SignBit(double number)
+        {
+            return (std::bit_cast<std::uint64_t>(number) >> 63) != 0;
+        }
+
+        // number * 2^exponent for the exponents Exp can produce.
+        constexpr double ScaleByPowerOfTwo(double number, std::int64_t exponent)
+        {
+            while(exponent > 1023)
+            {
+                number *= 8.98846567431158e307;
+                exponent -= 1023;
+            }
+            while(exponent < -1022)
+            {
+                number *= 2.2250738585072014e-308;
+                exponent += 1022;
+            }
+            return number * std::bit_cast<double>(static_cast<std::uint64_t>(exponent + 1023) << 52);
+        }
+
+        // Sine and cosine over [-pi / 4, pi / 4] by their Taylor series.
+        constexpr double SinSeries(double number)
+        {
+            const double square = number * number;
+            double term = number;
+            double sum = number;
+            for(int n = 2; n < 24; n += 2)
+            {
+                term *= -square / (n * (n + 1));
+                sum += term;
+            }
+            return sum;
+        }
+
+        constexpr double CosSeries(double number)
+        {
+            const double square = number * number;
+            double term = 1;
+            double sum = 1;
+            for(int n = 1; n < 24; n += 2)
+            {
+                term *= -square / (n * (n + 1));
+                sum += term;
+            }
+            return sum;
+        }
+    }
+
+    constexpr double Floor(double number)
+    {
+        if(Detail::IsNaN(number) || number == 0 || number >= 4503599627370496.0 || number <= -4503599627370496.0) return number;
+        const double truncated = static_cast<double>(static_cast<std::int64_t>(number));
+        return truncated > number ? truncated - 1 : truncated;
+    }
+
+    constexpr double Ceil(double number)
+    {
+        return -Floor(-number);
+    }
+
+    // Halfway cases round away from zero, as std::round.
+    constexpr double Round(double number)
+    {
+        const double magnitude = number < 0 ? -number : number;
+        double rounded = Floor(magnitude);
+        if(magnitude - rounded >= 0.5) rounded += 1;
+        return number < 0 ? -rounded : rounded;
+    }
+
+    constexpr double Sqrt(double number)
+    {
+        if(Detail::IsNaN(number) || number < 0) return Detail::NaN;
+        if(number == 0 || number == Detail::Infinity) return number;
+
+        // Halving the exponent bits starts Newton's method within a few percent.
+        double root = std::bit_cast<double>((std::bit_cast<std::uint64_t>(number) >> 1) + (std::uint64_t(1023) << 51));
+        for(int i = 0; i < 8; i++)
+        {
+            const double next = 0.5 * (root + number / root);
+            if(next == root) break;
+            root = next;
+        }
+        return root;
+    }
+
+    constexpr double Exp(double number)
+    {
+        if(Detail::IsNaN(number)) return number;
+        if(number > 709.8) return Detail::Infinity;
+        if(number < -745.2) return 0;
+
+        const double scaled = number * 1.4426950408889634;
+        const std::int64_t exponent = static_cast<std::int64_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+        const double reduced = (number - exponent * Detail::Ln2High) - exponent * Detail::Ln2Low;
+
+        double term = 1;
+        double sum = 1;
+        for(int n = 1; n < 24; n++)
+        {
+            term *= reduced / n;
+            sum += term;
+        }
+        return Detail::ScaleByPowerOfTwo(sum, exponent);
+    }
+
+    constexpr double Ln(double number)
+    {
+        if(Detail::IsNaN(number) || number < 0) return Detail::NaN;
+        if(number == 0) return -Detail::Infinity;
+        if(number == Detail::Infinity) return number;
+
+        std::int64_t exponent = 0;
+        if(number < 2.2250738585072014e-308)
+        {
+            number *= 18014398509481984.0;
+            exponent -= 54;
+        }
+        const std::uint64_t bits = std::bit_cast<std::uint64_t>(number);
+        exponent += static_cast<std::int64_t>(bits >> 52) - 1023;
+        double mantissa = std::bit_cast<double>((bits & 0x000FFFFFFFFFFFFFu) | (std::uint64_t(1023) << 52));
+        if(mantissa > 1.4142135623730951)
+        {
+            mantissa *= 0.5;
+            exponent++;
+        }
+
+        // ln(m) = 2 * atanh((m - 1) / (m + 1)), with |(m - 1) / (m + 1)| <= 0.172.
+        const double ratio = (mantissa - 1) / (mantissa + 1);
+        const double square = ratio * ratio;
+        double power = ratio;
+        double sum = 0;
+        for(int n = 1; n < 40; n += 2)
+        {
+            sum += power / n;
+            power *= square;
+        }
+        return exponent * Detail::Ln2High + (2 * sum + exponent * Detail::Ln2Low);
+    }
+
+    constexpr double Pow(double number, double power)
+    {
+        if(power == 0 || number == 1) return 1;
+        if(Detail::IsNaN(number) || Detail::IsNaN(power)) return Detail::NaN;
+
+        const bool integral = Floor(power) == power;
+        if(number < 0 && !integral) return Detail::NaN;
+        if(number == 0) return power > 0 ? 0 : Detail::Infinity;
+
+        const double magnitude = Exp(power * Ln(number < 0 ? -number : number));
+        const bool odd = integral && (power < 0 ? -power : power) < 9007199254740992.0 && Floor(power * 0.5) != power * 0.5;
+        return number < 0 && odd ? -magnitude : magnitude;
+    }
+
+    constexpr void SinCos(double number, double& sin, double& cos)
+    {
+        if(Detail::IsNaN(number) || number == Detail::Infinity || number == -Detail::Infinity)
+        {
+            sin = cos = Detail::NaN;
+            return;
+        }
+
+        // number - quadrant * pi / 2 lands in [-pi / 4, pi / 4]; the first two parts of pi / 2 have trailing zero bits,
+        // so their products stay exact for the quadrants of the documented range.
+        const double rounded = Round(number * (2 / Detail::PI));
+        const double reduced = ((number - rounded * Detail::HalfPI1) - rounded * Detail::HalfPI2) - rounded * Detail::HalfPI3 -
+            rounded * Detail::HalfPI3Tail;
+        const int quadrant = static_cast<int>(rounded - 4 * Floor(rounded * 0.25));
+        const double s = Detail::SinSeries(reduced);
+        const double c = Detail::CosSeries(reduced);
+        sin = quadrant == 0 ? s : quadrant == 1 ? c : quadrant == 2 ? -s : -c;
+        cos = quadrant == 0 ? c : quadrant == 1 ? -s : quadrant == 2 ? -c : s;
+    }
+
+    constexpr double Sin(double number)
+    {
+        double sin = 0, cos = 0;
+        SinCos(number, sin, cos);
+        return sin;
+    }
+
+    constexpr double Cos(double number)
+    {
+        double sin = 0, cos = 0;
+        SinCos(number, sin, cos);
+        return cos;
+    }
+
+    constexpr double Tan(double number)
+    {
+        double sin = 0, cos = 0;
+        SinCos(number, sin, cos);
+        return sin / cos;
+    }
+
+    constexpr double Atan(double number)
+    {
+        if(Detail::IsNaN(number) || number == 0) return number;
+
+        const bool negative = number < 0;
+        double magnitude = negative ? -number : number;
+        const bool inverted = magnitude > 1;
+        if(inverted) magnitude = 1 / magnitude;
+
+        // Two angle halvings bring the argument below tan(pi / 16), where the series converges quickly.
+        for(int i = 0; i < 2; i++) magnitude /= 1 + Sqrt(1 + magnitude * magnitude);
+        const double square = magnitude * magnitude;
+        double power = magnitude;
+        double sum = 0;
+        for(int n = 1; n < 40; n += 2)
+        {
+            sum += (n & 2 ? -power : power) / n;
+            power *= square;
+        }
+
+        double angle = 4 * sum;
+        if(inverted) angle = Detail::HalfPI - angle;
+        return negative ? -angle : angle;
+    }
+
+    constexpr double Atan2(double y, double x)
+    {
+        if(Detail::IsNaN(y) || Detail::IsNaN(x)) return Detail::NaN;
+
+        const bool yInfinite = y == Detail::Infinity || y == -Detail::Infinity;
+        const bool xInfinite = x == Detail::Infinity || x == -Detail::Infinity;
+        if(yInfinite && xInfinite)
+        {
+            const double angle = x > 0 ? Detail::PI / 4 : 3 * Detail::PI / 4;
+            return y < 0 ? -angle : angle;
+        }
+        if(y == 0)
+        {
+            if(x > 0 || (x == 0 && !Detail::SignBit(x))) return y;
+            return Detail::SignBit(y) ? -Detail::PI : Detail::PI;
+        }
+        if(x == 0 || yInfinite) return y < 0 ? -Detail::HalfPI : Detail::HalfPI;
+
+        const double angle = Atan(y / x);
+        if(x > 0) return angle;
+        return y < 0 ? angle - Detail::PI : angle + Detail::PI;
+    }
+
+    constexpr double Asin(double number)
+    {
+        if(!(number >= -1 && number <= 1)) return Detail::NaN;
+        return Atan2(number, Sqrt((1 - number) * (1 + number)));
+    }
+
+    constexpr double Acos(double number)
+    {
+        if(!(number >= -1 && number <= 1)) return Detail::NaN;
+        return Atan2(Sqrt((1 - number) * (1 + number)), number);
+    }
+}
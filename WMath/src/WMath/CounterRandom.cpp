@@ -0,0 +1,147 @@
+﻿#include "CounterRandom.hpp"
+
+#include "WMath/Parallel.hpp"
+#include "WMath/Simd.hpp"
+
+namespace
+{
+    constexpr std::size_t ChunkSize = 256;
+
+#if defined(WMATH_AVX2)
+    constexpr int BlockGroups = 2;
+    constexpr std::size_t BlocksPerCall = 8 * BlockGroups;
+
+    // Philox4x32::Generate for the BlocksPerCall blocks starting at block, one block per lane. The rounds are a long
+    // dependency chain, so independent groups of eight blocks are interleaved to keep the multipliers busy.
+    void GenerateBlocks(std::uint64_t seed, std::uint64_t stream, std::uint64_t block, std::uint32_t* out)
+    {
+        alignas(32) std::uint32_t low[BlocksPerCall];
+        alignas(32) std::uint32_t high[BlocksPerCall];
+        for(std::size_t i = 0; i < BlocksPerCall; i++)
+        {
+            low[i] = static_cast<std::uint32_t>(block + i);
+            high[i] = static_cast<std::uint32_t>((block + i) >> 32);
+        }
+
+        __m256i counter0[BlockGroups], counter1[BlockGroups], counter2[BlockGroups], counter3[BlockGroups];
+        for(int group = 0; group < BlockGroups; group++)
+        {
+            counter0[group] = _mm256_load_si256(reinterpret_cast<const __m256i*>(low) + group);
+            counter1[group] = _mm256_load_si256(reinterpret_cast<const __m256i*>(high) + group);
+            counter2[group] = _mm256_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(stream)));
+            counter3[group] = _mm256_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(stream >> 32)));
+        }
+        const __m256i multiplier0 = _mm256_set1_epi32(static_cast<int>(WMath::Philox4x32::Multiplier0));
+        const __m256i multiplier1 = _mm256_set1_epi32(static_cast<int>(WMath::Philox4x32::Multiplier1));
+        std::uint32_t key0 = static_cast<std::uint32_t>(seed);
+        std::uint32_t key1 = static_cast<std::uint32_t>(seed >> 32);
+
+        // mul_epu32 only multiplies the even lanes, so the odd lanes are shifted down and the halves blended back.
+        const auto multiply = [](__m256i value, __m256i multiplier, __m256i& productHigh, __m256i& productLow)
+        {
+            const __m256i even = _mm256_mul_epu32(value, multiplier);
+            const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(value, 32), multiplier);
+            productLow = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+            productHigh = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+        };
+
+        for(int round = 0; round < WMath::Philox4x32::Rounds; round++)
+        {
+            const __m256i roundKey0 = _mm256_set1_epi32(static_cast<int>(key0));
+            const __m256i roundKey1 = _mm256_set1_epi32(static_cast<int>(key1));
+            for(int group = 0; group < BlockGroups; group++)
+            {
+                __m256i high0, low0, high1, low1;
+                multiply(counter0[group], multiplier0, high0, low0);
+                multiply(counter2[group], multiplier1, high1, low1);
+                counter0[group] = _mm256_xor_si256(_mm256_xor_si256(high1, counter1[group]), roundKey0);
+                counter2[group] = _mm256_xor_si256(_mm256_xor_si256(high0, counter3[group]), roundKey1);
+                counter1[group] = low1;
+                counter3[group] = low0;
+            }
+            key0 += WMath::Philox4x32::KeyIncrement0;
+            key1 += WMath::Philox4x32::KeyIncrement1;
+        }
+
+        // Transpose the four word vectors into consecutive blocks; each 128-bit half of u holds one block.
+        __m256i* destination = reinterpret_cast<__m256i*>(out);
+        for(int group = 0; group < BlockGroups; group++, destination += 4)
+        {
+            const __m256i t0 = _mm256_unpacklo_epi32(counter0[group], counter1[group]);
+            const __m256i t1 = _mm256_unpacklo_epi32(counter2[group], counter3[group]);
+            const __m256i t2 = _mm256_unpackhi_epi32(counter0[group], counter1[group]);
+            const __m256i t3 = _mm256_unpackhi_epi32(counter2[group], counter3[group]);
+            const __m256i u0 = _mm256_unpacklo_epi64(t0, t1);
+            const __m256i u1 = _mm256_unpackhi_epi64(t0, t1);
+            const __m256i u2 = _mm256_unpacklo_epi64(t2, t3);
+            const __m256i u3 = _mm256_unpackhi_epi64(t2, t3);
+            _mm256_storeu_si256(destination, _mm256_permute2x128_si256(u0, u1, 0x20));
+            _mm256_storeu_si256(destination + 1, _mm256_permute2x128_si256(u2, u3, 0x20));
+            _mm256_storeu_si256(destination + 2, _mm256_permute2x128_si256(u0, u1, 0x31));
+            _mm256_storeu_si256(destination + 3, _mm256_permute2x128_si256(u2, u3, 0x31));
+        }
+    }
+#endif
+}
+
+void WMath::CounterRandom::FillBits(std::uint64_t first, std::span<std::uint32_t> out, unsigned threadCount) const
+{
+    Parallel::For(out.size(), threadCount, [&](std::size_t begin, std::size_t end)
+    {
+        FillBlock(first + begin, out.data() + begin, end - begin);
+    });
+}
+
+void WMath::CounterRandom::FillUniform(std::uint64_t first, std::span<float> out, float min, float max, unsigned threadCount) const
+{
+    const float scale = max - min;
+    Parallel::For(out.size(), threadCount, [&](std::size_t begin, std::size_t end)
+    {
+        std::uint32_t bits[ChunkSize];
+        for(std::size_t offset = begin; offset < end; offset += ChunkSize)
+        {
+            const std::size_t count = end - offset < ChunkSize ? end - offset : ChunkSize;
+            FillBlock(first + offset, bits, count);
+            float* destination = out.data() + offset;
+            for(std::size_t i = 0; i < count; i++) destination[i] = min + RandomStream::UnitFloat(bits[i]) * scale;
+        }
+    });
+}
+
+void WMath::CounterRandom::FillUniform(std::uint64_t first, std::span<int> out, int min, int max, unsigned threadCount) const
+{
+    const std::uint32_t range = static_cast<std::uint32_t>(max) - static_cast<std::uint32_t>(min) + 1;
+    Parallel::For(out.size(), threadCount, [&](std::size_t begin, std::size_t end)
+    {
+        std::uint32_t bits[ChunkSize];
+        for(std::size_t offset = begin; offset < end; offset += ChunkSize)
+        {
+            const std::size_t count = end - offset < ChunkSize ? end - offset : ChunkSize;
+            FillBlock(first + offset, bits, count);
+            int* destination = out.data() + offset;
+            for(std::size_t i = 0; i < count; i++) destination[i] = BoundedInt(bits[i], range, min);
+        }
+    });
+}
+
+void WMath::CounterRandom::FillBlock(std::uint64_t first, std::uint32_t* out, std::size_t count) const
+{
+    std::size_t i = 0;
+    for(; i < count && ((first + i) & 3) != 0; i++) out[i] = GetBits(first + i);
+
+    std::uint64_t block = (first + i) >> 2;
+#if defined(WMATH_AVX2)
+    for(; i + 4 * BlocksPerCall <= count; i += 4 * BlocksPerCall, block += BlocksPerCall) GenerateBlocks(seed, stream, block, out + i);
+#endif
+    for(; i + 4 <= count; i += 4, block++)
+    {
+        const Philox4x32::Block words = Philox4x32::Generate(seed, stream, block);
+        for(int j = 0; j < 4; j++) out[i + j] = words[j];
+    }
+
+    if(i < count)
+    {
+        const Philox4x32::Block words = Philox4x32::Generate(seed, stream, block);
+        for(int j = 0; i < count; i++, j++) out[i] = words[j];
+    }
+}
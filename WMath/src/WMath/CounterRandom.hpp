@@ -0,0 +1,98 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "WMath/RandomEngines.hpp"
+#include "WMath/RandomStream.hpp"
+#include "WMath/Vector2.hpp"
+#include "WMath/Vector3.hpp"
+
+namespace WMath
+{
+    // Stateless random numbers on top of Philox4x32: value i of a (seed, stream) pair is a pure function of all three,
+    // so any index range can be generated on any thread, in any order or split, with identical results. The fills
+    // guarantee out[j] == GetBits(first + j) (or the matching conversion) regardless of threadCount, where 1 stays on
+    // the calling thread and anything else runs on ThreadPool::Global(), with 0 letting the pool balance the work.
+    class CounterRandom
+    {
+    public:
+        typedef unsigned long long SeedType;
+
+        CounterRandom() : CounterRandom(0) {}
+        explicit CounterRandom(SeedType seed, std::uint64_t stream = 0) : seed(seed), stream(stream) {}
+
+        SeedType GetSeed() const
+        {
+            return seed;
+        }
+        std::uint64_t GetStream() const
+        {
+            return stream;
+        }
+
+        // The same seed on another stream; streams never overlap.
+        CounterRandom WithStream(std::uint64_t newStream) const
+        {
+            return CounterRandom(seed, newStream);
+        }
+
+        std::uint32_t GetBits(std::uint64_t index) const
+        {
+            return Philox4x32::Get(seed, stream, index);
+        }
+
+        float GetValue(std::uint64_t index, float min, float max) const
+        {
+            return min + RandomStream::UnitFloat(GetBits(index)) * (max - min);
+        }
+
+        // Multiply-shift without rejection, since rejection would make value i depend on a variable number of draws.
+        // The bias is below range / 2^32.
+        int GetValue(std::uint64_t index, int min, int max) const
+        {
+            return BoundedInt(GetBits(index), static_cast<std::uint32_t>(max) - static_cast<std::uint32_t>(min) + 1, min);
+        }
+
+        // Vector i uses values 2i and 2i + 1, matching FillVector2.
+        Vector2 GetVector2(std::uint64_t index, float min, float max) const
+        {
+            return {GetValue(2 * index, min, max), GetValue(2 * index + 1, min, max)};
+        }
+
+        // Vector i uses values 3i to 3i + 2, matching FillVector3.
+        Vector3 GetVector3(std::uint64_t index, float min, float max) const
+        {
+            return {GetValue(3 * index, min, max), GetValue(3 * index + 1, min, max), GetValue(3 * index + 2, min, max)};
+        }
+
+        void FillBits(std::uint64_t first, std::span<std::uint32_t> out, unsigned threadCount = 1) const;
+        void FillUniform(std::uint64_t first, std::span<float> out, float min, float max, unsigned threadCount = 1) const;
+        void FillUniform(std::uint64_t first, std::span<int> out, int min, int max, unsigned threadCount = 1) const;
+
+        void FillVector2(std::uint64_t first, std::span<Vector2> out, float min, float max, unsigned threadCount = 1) const
+        {
+            static_assert(sizeof(Vector2) == 2 * sizeof(float));
+            FillUniform(2 * first, {reinterpret_cast<float*>(out.data()), out.size() * 2}, min, max, threadCount);
+        }
+
+        void FillVector3(std::uint64_t first, std::span<Vector3> out, float min, float max, unsigned threadCount = 1) const
+        {
+            static_assert(sizeof(Vector3) == 3 * sizeof(float));
+            FillUniform(3 * first, {reinterpret_cast<float*>(out.data()), out.size() * 3}, min, max, threadCount);
+        }
+
+    private:
+        SeedType seed;
+        std::uint64_t stream;
+
+        static int BoundedInt(std::uint32_t bits, std::uint32_t range, int min)
+        {
+            if(range == 0) return static_cast<int>(bits);
+            const std::uint32_t offset = static_cast<std::uint32_t>(static_cast<std::uint64_t>(bits) * range >> 32);
+            return static_cast<int>(static_cast<std::uint32_t>(min) + offset);
+        }
+
+        void FillBlock(std::uint64_t first, std::uint32_t* out, std::size_t count) const;
+    };
+}
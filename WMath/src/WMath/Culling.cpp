@@ -0,0 +1,168 @@
+﻿#include "Culling.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#include "WMath/Parallel.hpp"
+#include "WMath/Simd.hpp"
+
+namespace
+{
+    typedef WMath::Simd::NativeLanes Lanes;
+    typedef Lanes::Float Float;
+    typedef Lanes::Mask Mask;
+
+    // Lanes past count repeat the last element, so padding never produces values the real lanes could not.
+    Float LoadLanes(const float* source, std::size_t count)
+    {
+        if(count == Lanes::Width) return Lanes::Load(source);
+
+        float padded[Lanes::Width];
+        for(std::size_t lane = 0; lane < Lanes::Width; lane++) padded[lane] = source[std::min(lane, count - 1)];
+        return Lanes::Load(padded);
+    }
+
+    struct SphereLanes
+    {
+        Float x;
+        Float y;
+        Float z;
+        Float radius;
+
+        SphereLanes(const WMath::Vector3Array& centers, std::span<const float> radii, std::size_t first, std::size_t count)
+            : x(LoadLanes(centers.x.data() + first, count)), y(LoadLanes(centers.y.data() + first, count)),
+            z(LoadLanes(centers.z.data() + first, count)), radius(LoadLanes(radii.data() + first, count)) {}
+
+        Float Reach(const WMath::Plane&) const
+        {
+            return radius;
+        }
+    };
+
+    struct BoxLanes
+    {
+        Float x;
+        Float y;
+        Float z;
+        Float extentX;
+        Float extentY;
+        Float extentZ;
+
+        BoxLanes(const WMath::Vector3Array& centers, const WMath::Vector3Array& extents, std::size_t first, std::size_t count)
+            : x(LoadLanes(centers.x.data() + first, count)), y(LoadLanes(centers.y.data() + first, count)),
+            z(LoadLanes(centers.z.data() + first, count)), extentX(LoadLanes(extents.x.data() + first, count)),
+            extentY(LoadLanes(extents.y.data() + first, count)), extentZ(LoadLanes(extents.z.data() + first, count)) {}
+
+        Float Reach(const WMath::Plane& plane) const
+        {
+            return Lanes::Add(Lanes::Add(Lanes::Mul(Lanes::Set(WMath::Abs(plane.normal.x)), extentX),
+                Lanes::Mul(Lanes::Set(WMath::Abs(plane.normal.y)), extentY)), Lanes::Mul(Lanes::Set(WMath::Abs(plane.normal.z)), extentZ));
+        }
+    };
+
+    template<typename Bounds>
+    Float Distance(const WMath::Plane& plane, const Bounds& bounds)
+    {
+        const Float dot = Lanes::Add(Lanes::Add(Lanes::Mul(Lanes::Set(plane.normal.x), bounds.x), Lanes::Mul(Lanes::Set(plane.normal.y), bounds.y)),
+            Lanes::Mul(Lanes::Set(plane.normal.z), bounds.z));
+        return Lanes::Add(dot, Lanes::Set(plane.distance));
+    }
+
+    // Stops testing as soon as every lane is culled, which is most blocks once the frustum covers a small part of the
+    // scene.
+    template<typename Bounds>
+    Mask Visible(const WMath::Frustum& frustum, std::span<const WMath::Frustum> occluders, const Bounds& bounds)
+    {
+        const Float zero = Lanes::Set(0.0f);
+        Mask visible = Lanes::LessEqual(Lanes::Sub(zero, bounds.Reach(frustum.planes[0])), Distance(frustum.planes[0], bounds));
+        for(int side = 1; side < WMath::Frustum::SideCount && Lanes::Any(visible); side++)
+        {
+            const WMath::Plane& plane = frustum.planes[side];
+            visible = Lanes::And(visible, Lanes::LessEqual(Lanes::Sub(zero, bounds.Reach(plane)), Distance(plane, bounds)));
+        }
+
+        for(const WMath::Frustum& occluder : occluders)
+        {
+            if(!Lanes::Any(visible)) break;
+
+            Mask exposed = Lanes::Less(Distance(occluder.planes[0], bounds), bounds.Reach(occluder.planes[0]));
+            for(int side = 1; side < WMath::Frustum::SideCount; side++)
+            {
+                const WMath::Plane& plane = occluder.planes[side];
+                exposed = Lanes::Or(exposed, Lanes::Less(Distance(plane, bounds), bounds.Reach(plane)));
+            }
+            visible = Lanes::And(visible, exposed);
+        }
+        return visible;
+    }
+
+    // Culls [begin, end) into visible from begin onwards, which never overtakes the element being tested.
+    template<typename LoadBounds>
+    std::size_t CullRange(const WMath::Frustum& frustum, std::span<const WMath::Frustum> occluders, std::size_t begin, std::size_t end,
+        std::span<std::uint32_t> visible, const LoadBounds& loadBounds)
+    {
+        std::size_t found = begin;
+        for(std::size_t first = begin; first < end; first += Lanes::Width)
+        {
+            const std::size_t count = std::min<std::size_t>(Lanes::Width, end - first);
+            const int mask = Lanes::MoveMask(Visible(frustum, occluders, loadBounds(first, count)));
+            if(mask == 0) continue;
+
+            for(std::size_t lane = 0; lane < count; lane++)
+            {
+                visible[found] = static_cast<std::uint32_t>(first + lane);
+                found += mask >> lane & 1;
+            }
+        }
+        return found - begin;
+    }
+
+    template<typename LoadBounds>
+    std::size_t Cull(const WMath::Frustum& frustum, std::span<const WMath::Frustum> occluders, std::size_t count,
+        std::span<std::uint32_t> visible, unsigned threadCount, const LoadBounds& loadBounds)
+    {
+        assert(visible.size() >= count);
+        assert(count <= std::numeric_limits<std::uint32_t>::max());
+        // Chunks start on a lane boundary, so only the last one loads a partial packet.
+        return WMath::Parallel::Compact(count, threadCount, [&](std::size_t begin, std::size_t end)
+        {
+            return CullRange(frustum, occluders, begin, end, visible, loadBounds);
+        }, [&](std::size_t from, std::size_t size, std::size_t to)
+        {
+            std::copy(visible.begin() + from, visible.begin() + from + size, visible.begin() + to);
+        }, WMath::Parallel::DefaultGrainSize, Lanes::Width);
+    }
+}
+
+std::size_t WMath::Culling::Spheres(const Frustum& frustum, const Vector3Array& centers, std::span<const float> radii,
+    std::span<std::uint32_t> visible, unsigned threadCount)
+{
+    return Spheres(frustum, {}, centers, radii, visible, threadCount);
+}
+
+std::size_t WMath::Culling::Spheres(const Frustum& frustum, std::span<const Frustum> occluders, const Vector3Array& centers,
+    std::span<const float> radii, std::span<std::uint32_t> visible, unsigned threadCount)
+{
+    assert(radii.size() == centers.Size());
+    return Cull(frustum, occluders, centers.Size(), visible, threadCount, [&](std::size_t first, std::size_t count)
+    {
+        return SphereLanes(centers, radii, first, count);
+    });
+}
+
+std::size_t WMath::Culling::Boxes(const Frustum& frustum, const Vector3Array& centers, const Vector3Array& extents,
+    std::span<std::uint32_t> visible, unsigned threadCount)
+{
+    return Boxes(frustum, {}, centers, extents, visible, threadCount);
+}
+
+std::size_t WMath::Culling::Boxes(const Frustum& frustum, std::span<const Frustum> occluders, const Vector3Array& centers,
+    const Vector3Array& extents, std::span<std::uint32_t> visible, unsigned threadCount)
+{
+    assert(extents.Size() == centers.Size());
+    return Cull(frustum, occluders, centers.Size(), visible, threadCount, [&](std::size_t first, std::size_t count)
+    {
+        return BoxLanes(centers, extents, first, count);
+    });
+}
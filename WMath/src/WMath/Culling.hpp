@@ -0,0 +1,25 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <span>
+#include "WMath/Frustum.hpp"
+#include "WMath/Vector3Array.hpp"
+
+namespace WMath::Culling
+{
+    // Tests structure-of-arrays bounds against a frustum Simd::NativeLanes at a time, matching Frustum::Intersects and
+    // Frustum::Contains up to rounding. visible receives the indices of the bounds that intersect frustum and are not
+    // wholly inside any occluder, in increasing order, and the count is returned; it needs room for every bound. A
+    // threadCount other than 1 splits the bounds over ThreadPool::Global(), with 0 letting the pool balance the work.
+
+    std::size_t Spheres(const Frustum& frustum, const Vector3Array& centers, std::span<const float> radii,
+        std::span<std::uint32_t> visible, unsigned threadCount = 1);
+    std::size_t Spheres(const Frustum& frustum, std::span<const Frustum> occluders, const Vector3Array& centers,
+        std::span<const float> radii, std::span<std::uint32_t> visible, unsigned threadCount = 1);
+
+    // Boxes are given by their centers and extents, as AABB::Center and AABB::Extents.
+    std::size_t Boxes(const Frustum& frustum, const Vector3Array& centers, const Vector3Array& extents,
+        std::span<std::uint32_t> visible, unsigned threadCount = 1);
+    std::size_t Boxes(const Frustum& frustum, std::span<const Frustum> occluders, const Vector3Array& centers,
+        const Vector3Array& extents, std::span<std::uint32_t> visible, unsigned threadCount = 1);
+}
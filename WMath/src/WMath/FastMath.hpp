@@ -0,0 +1,494 @@
+﻿#pragma once
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "WMath/Simd.hpp"
+#include "WMath/Utils.hpp"
+
+namespace WMath
+{
+    enum class Precision
+    {
+        Exact,
+        Fast
+    };
+}
+
+namespace WMath::Fast::Detail
+{
+    // Branchless kernels shared by the scalar functions below and the span batches; L is a lane set from Simd.hpp.
+
+    template<typename L>
+    typename L::Float FlipSign(typename L::Float value, typename L::Int signBits)
+    {
+        return L::AsFloat(L::IntXor(L::AsInt(value), signBits));
+    }
+
+    template<typename L>
+    typename L::Float CopySign(typename L::Float magnitude, typename L::Float sign)
+    {
+        return FlipSign<L>(magnitude, L::IntAnd(L::AsInt(sign), L::SetInt(static_cast<std::int32_t>(0x80000000u))));
+    }
+
+    template<typename L>
+    typename L::Int RoundToInt(typename L::Float value)
+    {
+        return L::ToInt(L::Add(value, CopySign<L>(L::Set(0.5f), value)));
+    }
+
+    template<typename L>
+    typename L::Float InvSqrt(typename L::Float value)
+    {
+        const typename L::Float estimate = L::InvSqrtEstimate(value);
+        const typename L::Float halfValue = L::Mul(L::Set(0.5f), value);
+        return L::Mul(estimate, L::Sub(L::Set(1.5f), L::Mul(halfValue, L::Mul(estimate, estimate))));
+    }
+
+    template<typename L>
+    typename L::Float Sqrt(typename L::Float value)
+    {
+        return L::Mul(value, InvSqrt<L>(L::Max(value, L::Set(std::numeric_limits<float>::min()))));
+    }
+
+    // Beyond this the three-part reduction below loses too much of the argument, and the quadrant would soon overflow int.
+    constexpr float SinCosLimit = 100000.0f;
+
+    template<typename L>
+    void SinCos(typename L::Float value, typename L::Float& sin, typename L::Float& cos)
+    {
+        typedef typename L::Float Float;
+        typedef typename L::Int Int;
+
+        // Out-of-range lanes, NaN included, reduce from 0 so the conversion stays defined; they are patched below.
+        const typename L::Mask inRange = L::LessEqual(L::Abs(value), L::Set(SinCosLimit));
+        const Int quadrant = RoundToInt<L>(L::Select(inRange, L::Mul(value, L::Set(2.0f * InvPI)), L::Set(0.0f)));
+        const Float quadrantFloat = L::ToFloat(quadrant);
+
+        Float x = L::Sub(value, L::Mul(quadrantFloat, L::Set(1.5703125f)));
+        x = L::Sub(x, L::Mul(quadrantFloat, L::Set(4.837512969970703125e-4f)));
+        x = L::Sub(x, L::Mul(quadrantFloat, L::Set(7.549789948768648e-8f)));
+        const Float x2 = L::Mul(x, x);
+
+        Float sinPolynomial = L::Add(L::Mul(L::Set(-1.9515295891e-4f), x2), L::Set(8.3321608736e-3f));
+        sinPolynomial = L::Add(L::Mul(sinPolynomial, x2), L::Set(-1.6666654611e-1f));
+        sinPolynomial = L::Add(L::Mul(L::Mul(sinPolynomial, x2), x), x);
+
+        Float cosPolynomial = L::Add(L::Mul(L::Set(2.443315711809948e-5f), x2), L::Set(-1.388731625493765e-3f));
+        cosPolynomial = L::Add(L::Mul(cosPolynomial, x2), L::Set(4.166664568298827e-2f));
+        cosPolynomial = L::Add(L::Mul(L::Mul(cosPolynomial, x2), x2), L::Sub(L::Set(1.0f), L::Mul(L::Set(0.5f), x2)));
+
+        const typename L::Mask swap = L::Greater(L::ToFloat(L::IntAnd(quadrant, L::SetInt(1))), L::Set(0.0f));
+        const Int sinSign = L::template IntShiftLeft<30>(L::IntAnd(quadrant, L::SetInt(2)));
+        const Int cosSign = L::template IntShiftLeft<30>(L::IntAnd(L::IntAdd(quadrant, L::SetInt(1)), L::SetInt(2)));
+
+        sin = FlipSign<L>(L::Select(swap, cosPolynomial, sinPolynomial), sinSign);
+        cos = FlipSign<L>(L::Select(swap, sinPolynomial, cosPolynomial), cosSign);
+
+        if(!L::Any(L::Greater(L::Abs(value), L::Set(SinCosLimit)))) return;
+        float values[L::Width], sines[L::Width], cosines[L::Width];
+        L::Store(values, value);
+        L::Store(sines, sin);
+        L::Store(cosines, cos);
+        for(int lane = 0; lane < L::Width; lane++)
+        {
+            if(!(std::abs(values[lane]) > SinCosLimit)) continue;
+            sines[lane] = std::sin(values[lane]);
+            cosines[lane] = std::cos(values[lane]);
+        }
+        sin = L::Load(sines);
+        cos = L::Load(cosines);
+    }
+
+    template<typename L>
+    typename L::Float Asin(typename L::Float value, typename L::Float& reduced, typename L::Mask& large)
+    {
+        typedef typename L::Float Float;
+
+        const Float x = L::Abs(value);
+        large = L::Greater(x, L::Set(0.5f));
+        const Float z = L::Select(large, L::Mul(L::Set(0.5f), L::Sub(L::Set(1.0f), x)), L::Mul(x, x));
+        const Float s = L::Select(large, L::Sqrt(z), x);
+
+        Float polynomial = L::Add(L::Mul(L::Set(4.2163199048e-2f), z), L::Set(2.4181311049e-2f));
+        polynomial = L::Add(L::Mul(polynomial, z), L::Set(4.5470025998e-2f));
+        polynomial = L::Add(L::Mul(polynomial, z), L::Set(7.4953002686e-2f));
+        polynomial = L::Add(L::Mul(polynomial, z), L::Set(1.6666752422e-1f));
+        reduced = L::Add(L::Mul(L::Mul(polynomial, z), s), s);
+
+        return CopySign<L>(L::Select(large, L::Sub(L::Set(HalfPI), L::Add(reduced, reduced)), reduced), value);
+    }
+
+    template<typename L>
+    typename L::Float Acos(typename L::Float value)
+    {
+        typedef typename L::Float Float;
+
+        Float reduced;
+        typename L::Mask large;
+        const Float asin = Asin<L>(value, reduced, large);
+
+        const Float doubled = L::Add(reduced, reduced);
+        const Float largeResult = L::Select(L::Less(value, L::Set(0.0f)), L::Sub(L::Set(PI), doubled), doubled);
+        return L::Select(large, largeResult, L::Sub(L::Set(HalfPI), asin));
+    }
+
+    // Evaluates atan(numerator / denominator) + offset for ratios already reduced to |ratio| <= tan(pi / 8).
+    template<typename L>
+    typename L::Float AtanReduced(typename L::Float numerator, typename L::Float denominator, typename L::Float offset)
+    {
+        typedef typename L::Float Float;
+
+        const Float x = L::Div(numerator, denominator);
+        const Float x2 = L::Mul(x, x);
+
+        Float polynomial = L::Add(L::Mul(L::Set(8.05374449538e-2f), x2), L::Set(-1.38776856032e-1f));
+        polynomial = L::Add(L::Mul(polynomial, x2), L::Set(1.99777106478e-1f));
+        polynomial = L::Add(L::Mul(polynomial, x2), L::Set(-3.33329491539e-1f));
+        return L::Add(offset, L::Add(L::Mul(L::Mul(polynomial, x2), x), x));
+    }
+
+    template<typename L>
+    typename L::Float Atan(typename L::Float value)
+    {
+        typedef typename L::Float Float;
+
+        const Float x = L::Abs(value);
+        const typename L::Mask large = L::Greater(x, L::Set(2.414213562373095f));
+        const typename L::Mask medium = L::Greater(x, L::Set(0.4142135623730950f));
+
+        const Float numerator = L::Select(large, L::Set(-1.0f), L::Select(medium, L::Sub(x, L::Set(1.0f)), x));
+        const Float denominator = L::Select(large, x, L::Select(medium, L::Add(x, L::Set(1.0f)), L::Set(1.0f)));
+        const Float offset = L::Select(large, L::Set(HalfPI), L::Select(medium, L::Set(QuarterPI), L::Set(0.0f)));
+
+        return CopySign<L>(AtanReduced<L>(numerator, denominator, offset), value);
+    }
+
+    template<typename L>
+    typename L::Float Atan2(typename L::Float y, typename L::Float x)
+    {
+        typedef typename L::Float Float;
+
+        const Float absY = L::Abs(y);
+        const Float absX = L::Abs(x);
+        const Float minimum = L::Min(absX, absY);
+        const Float maximum = L::Max(L::Max(absX, absY), L::Set(std::numeric_limits<float>::min()));
+
+        const typename L::Mask medium = L::Greater(minimum, L::Mul(maximum, L::Set(0.4142135623730950f)));
+        const Float numerator = L::Select(medium, L::Sub(minimum, maximum), minimum);
+        const Float denominator = L::Select(medium, L::Add(minimum, maximum), maximum);
+        Float angle = AtanReduced<L>(numerator, denominator, L::Select(medium, L::Set(QuarterPI), L::Set(0.0f)));
+
+        angle = L::Select(L::Greater(absY, absX), L::Sub(L::Set(HalfPI), angle), angle);
+        angle = L::Select(L::Less(x, L::Set(0.0f)), L::Sub(L::Set(PI), angle), angle);
+        return CopySign<L>(angle, y);
+    }
+
+    template<typename L>
+    typename L::Float Exp(typename L::Float value)
+    {
+        typedef typename L::Float Float;
+
+        // Adding 1.5 * 2^23 rounds to the nearest integer and leaves it in the low mantissa bits.
+        const Float roundingMagic = L::Set(12582912.0f);
+        const Float x = L::Min(L::Max(value, L::Set(-87.33654f)), L::Set(88.7228317f));
+        const Float shifted = L::Add(L::Mul(x, L::Set(1.44269504088896341f)), roundingMagic);
+        const Float exponentFloat = L::Sub(shifted, roundingMagic);
+        const typename L::Int exponent = L::IntSub(L::AsInt(shifted), L::AsInt(roundingMagic));
+
+        Float r = L::Sub(x, L::Mul(exponentFloat, L::Set(0.693359375f)));
+        r = L::Sub(r, L::Mul(exponentFloat, L::Set(-2.12194440e-4f)));
+
+        Float polynomial = L::Add(L::Mul(L::Set(1.9875691500e-4f), r), L::Set(1.3981999507e-3f));
+        polynomial = L::Add(L::Mul(polynomial, r), L::Set(8.3334519073e-3f));
+        polynomial = L::Add(L::Mul(polynomial, r), L::Set(4.1665795894e-2f));
+        polynomial = L::Add(L::Mul(polynomial, r), L::Set(1.6666665459e-1f));
+        polynomial = L::Add(L::Mul(polynomial, r), L::Set(5.0000001201e-1f));
+        polynomial = L::Add(L::Add(L::Mul(L::Mul(polynomial, r), r), r), L::Set(1.0f));
+
+        Float result = L::AsFloat(L::IntAdd(L::AsInt(polynomial), L::template IntShiftLeft<23>(exponent)));
+        result = L::Select(L::Less(value, L::Set(-87.33654f)), L::Set(0.0f), result);
+        return L::Select(L::Greater(value, L::Set(88.7228317f)), L::Set(std::numeric_limits<float>::infinity()), result);
+    }
+
+    template<typename L>
+    typename L::Float Ln(typename L::Float value)
+    {
+        typedef typename L::Float Float;
+
+        const typename L::Int bits = L::AsInt(value);
+        Float mantissa = L::AsFloat(L::IntOr(L::IntAnd(bits, L::SetInt(0x007FFFFF)), L::SetInt(0x3F800000)));
+        Float exponent = L::ToFloat(L::IntSub(L::template IntShiftRight<23>(bits), L::SetInt(127)));
+
+        const typename L::Mask large = L::Greater(mantissa, L::Set(1.41421356237309505f));
+        mantissa = L::Select(large, L::Mul(mantissa, L::Set(0.5f)), mantissa);
+        exponent = L::Select(large, L::Add(exponent, L::Set(1.0f)), exponent);
+
+        const Float x = L::Sub(mantissa, L::Set(1.0f));
+        const Float x2 = L::Mul(x, x);
+
+        Float polynomial = L::Add(L::Mul(L::Set(7.0376836292e-2f), x), L::Set(-1.1514610310e-1f));
+        polynomial = L::Add(L::Mul(polynomial, x), L::Set(1.1676998740e-1f));
+        polynomial = L::Add(L::Mul(polynomial, x), L::Set(-1.2420140846e-1f));
+        polynomial = L::Add(L::Mul(polynomial, x), L::Set(1.4249322787e-1f));
+        polynomial = L::Add(L::Mul(polynomial, x), L::Set(-1.6668057665e-1f));
+        polynomial = L::Add(L::Mul(polynomial, x), L::Set(2.0000714765e-1f));
+        polynomial = L::Add(L::Mul(polynomial, x), L::Set(-2.4999993993e-1f));
+        polynomial = L::Add(L::Mul(polynomial, x), L::Set(3.3333331174e-1f));
+
+        Float result = L::Mul(L::Mul(polynomial, x2), x);
+        result = L::Add(result, L::Mul(exponent, L::Set(-2.12194440e-4f)));
+        result = L::Sub(result, L::Mul(L::Set(0.5f), x2));
+        result = L::Add(L::Add(result, x), L::Mul(exponent, L::Set(0.693359375f)));
+
+        result = L::Select(L::LessEqual(value, L::Set(0.0f)), L::Set(-std::numeric_limits<float>::infinity()), result);
+        return L::Select(L::Less(value, L::Set(0.0f)), L::Set(std::numeric_limits<float>::quiet_NaN()), result);
+    }
+
+    template<typename L>
+    typename L::Float Pow(typename L::Float number, typename L::Float power)
+    {
+        return Exp<L>(L::Mul(power, Ln<L>(number)));
+    }
+}
+
+namespace WMath::Fast
+{
+    // Polynomial approximations for hot paths. Errors below are measured against the double-precision libm result;
+    // relative errors are taken against max(|result|, 1e-6) and exclude the listed domain edges.
+
+    // Max relative error 3e-7 over positive normal inputs.
+    inline float InvSqrt(float number)
+    {
+        return Detail::InvSqrt<Simd::ScalarLanes>(number);
+    }
+
+    // Same error as InvSqrt over non-negative inputs; negative inputs are not handled.
+    inline float Sqrt(float number)
+    {
+        return Detail::Sqrt<Simd::ScalarLanes>(number);
+    }
+
+    // Max absolute error 1e-7 for |number| <= 8192 and 1e-6 for |number| <= 100000. Larger finite inputs fall back to
+    // std::sin and std::cos, and infinities and NaN return NaN.
+    inline void SinCos(float number, float& sin, float& cos)
+    {
+        Detail::SinCos<Simd::ScalarLanes>(number, sin, cos);
+    }
+
+    inline float Sin(float number)
+    {
+        float sin, cos;
+        SinCos(number, sin, cos);
+        return sin;
+    }
+
+    inline float Cos(float number)
+    {
+        float sin, cos;
+        SinCos(number, sin, cos);
+        return cos;
+    }
+
+    // Max relative error 3e-7 away from the poles.
+    inline float Tan(float number)
+    {
+        float sin, cos;
+        SinCos(number, sin, cos);
+        return sin / cos;
+    }
+
+    // Max absolute error 2e-7 over [-1, 1]; inputs outside the domain return NaN.
+    inline float Asin(float number)
+    {
+        float reduced;
+        bool large;
+        return Detail::Asin<Simd::ScalarLanes>(number, reduced, large);
+    }
+
+    // Max absolute error 3e-7 over [-1, 1]; inputs outside the domain return NaN.
+    inline float Acos(float number)
+    {
+        return Detail::Acos<Simd::ScalarLanes>(number);
+    }
+
+    // Max absolute error 2e-7.
+    inline float Atan(float number)
+    {
+        return Detail::Atan<Simd::ScalarLanes>(number);
+    }
+
+    // Max absolute error 3e-7; Atan2(0, 0) returns 0.
+    inline float Atan2(float y, float x)
+    {
+        return Detail::Atan2<Simd::ScalarLanes>(y, x);
+    }
+
+    // Max relative error 1e-7 over [-87.33, 88.72]; inputs below flush to 0 and above return infinity.
+    inline float Exp(float number)
+    {
+        return Detail::Exp<Simd::ScalarLanes>(number);
+    }
+
+    // Max relative error 1e-7 over positive normal inputs; 0 returns -infinity and negative inputs return NaN.
+    inline float Ln(float number)
+    {
+        return Detail::Ln<Simd::ScalarLanes>(number);
+    }
+
+    inline float Log(float number, float base)
+    {
+        return Ln(number) / Ln(base);
+    }
+
+    inline float Log10(float number)
+    {
+        return Ln(number) * 0.434294481903251828f;
+    }
+
+    // Computed as Exp(power * Ln(number)), so the relative error grows by about 1e-7 * |power * Ln(number)|.
+    // Only positive bases are supported.
+    inline float Pow(float number, float power)
+    {
+        return Detail::Pow<Simd::ScalarLanes>(number, power);
+    }
+}
+
+namespace WMath
+{
+    template<Precision P>
+    constexpr float Acos(float number)
+    {
+        if constexpr(P == Precision::Fast) if(!std::is_constant_evaluated()) return Fast::Acos(number);
+        return Acos(number);
+    }
+
+    template<Precision P>
+    constexpr float Asin(float number)
+    {
+        if constexpr(P == Precision::Fast) if(!std::is_constant_evaluated()) return Fast::Asin(number);
+        return Asin(number);
+    }
+
+    template<Precision P>
+    constexpr float Atan(float number)
+    {
+        if constexpr(P == Precision::Fast) if(!std::is_constant_evaluated()) return Fast::Atan(number);
+        return Atan(number);
+    }
+
+    template<Precision P>
+    constexpr float Atan2(float y, float x)
+    {
+        if constexpr(P == Precision::Fast) if(!std::is_constant_evaluated()) return Fast::Atan2(y, x);
+        return Atan2(y, x);
+    }
+
+    template<Precision P>
+    constexpr float Cos(float number)
+    {
+        if constexpr(P == Precision::Fast) if(!std::is_constant_evaluated()) return Fast::Cos(number);
+        return Cos(number);
+    }
+
+    template<Precision P>
+    constexpr float Exp(float number)
+    {
+        if constexpr(P == Precision::Fast) if(!std::is_constant_evaluated()) return Fast::Exp(number);
+        return Exp(number);
+    }
+
+    template<Precision P>
+    constexpr float InvSqrt(float number)
+    {
+        if constexpr(P == Precision::Fast) if(!std::is_constant_evaluated()) return Fast::InvSqrt(number);
+        return InvSqrt(number);
+    }
+
+    template<Precision P>
+    constexpr float Ln(float number)
+    {
+        if constexpr(P == Precision::Fast) if(!std::is_constant_evaluated()) return Fast::Ln(number);
+        return Ln(number);
+    }
+
+    template<Precision P>
+    constexpr float Log(float number, float base)
+    {
+        if constexpr(P == Precision::Fast) if(!std::is_constant_evaluated()) return Fast::Log(number, base);
+        return Log(number, base);
+    }
+
+    template<Precision P>
+    constexpr float Log10(float number)
+    {
+        if constexpr(P == Precision::Fast) if(!std::is_constant_evaluated()) return Fast::Log10(number);
+        return Log10(number);
+    }
+
+    template<Precision P>
+    constexpr float Pow(float number, float power)
+    {
+        if constexpr(P == Precision::Fast) if(!std::is_constant_evaluated()) return Fast::Pow(number, power);
+        return Pow(number, power);
+    }
+
+    template<Precision P>
+    constexpr float Sin(float number)
+    {
+        if constexpr(P == Precision::Fast) if(!std::is_constant_evaluated()) return Fast::Sin(number);
+        return Sin(number);
+    }
+
+    template<Precision P>
+    constexpr void SinCos(float number, float& sin, float& cos)
+    {
+        if constexpr(P == Precision::Fast) if(!std::is_constant_evaluated()) return Fast::SinCos(number, sin, cos);
+        SinCos(number, sin, cos);
+    }
+
+    template<Precision P>
+    constexpr float Sqrt(float number)
+    {
+        if constexpr(P == Precision::Fast) if(!std::is_constant_evaluated()) return Fast::Sqrt(number);
+        return Sqrt(number);
+    }
+
+    template<Precision P>
+    constexpr float Tan(float number)
+    {
+        if constexpr(P == Precision::Fast) if(!std::is_constant_evaluated()) return Fast::Tan(number);
+        return Tan(number);
+    }
+
+    // Double precision has no fast kernels; both policies take the exact path so generic code can share one.
+    template<Precision P>
+    constexpr double Acos(double number)
+    {
+        if(std::is_constant_evaluated()) return Constexpr::Acos(number);
+        return std::acos(number);
+    }
+
+    template<Precision P>
+    constexpr double InvSqrt(double number)
+    {
+        if(std::is_constant_evaluated()) return 1.0 / Constexpr::Sqrt(number);
+        return 1.0 / std::sqrt(number);
+    }
+
+    template<Precision P>
+    constexpr void SinCos(double number, double& sin, double& cos)
+    {
+        if(std::is_constant_evaluated()) return Constexpr::SinCos(number, sin, cos);
+        sin = std::sin(number);
+        cos = std::cos(number);
+    }
+
+    template<Precision P>
+    constexpr double Sqrt(double number)
+    {
+        if(std::is_constant_evaluated()) return Constexpr::Sqrt(number);
+        return std::sqrt(number);
+    }
+}
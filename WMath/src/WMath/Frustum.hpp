@@ -0,0 +1,123 @@
+﻿#pragma once
+
+#include <limits>
+#include "WMath/AABB.hpp"
+#include "WMath/Matrix4x4.hpp"
+#include "WMath/Plane.hpp"
+#include "WMath/Sphere.hpp"
+#include "WMath/Vector3.hpp"
+
+namespace WMath
+{
+    // Convex volume bounded by six planes whose normals point inwards. Intersects is conservative: bounds near an edge
+    // or corner may pass without touching the volume, as usual for culling.
+    struct Frustum
+    {
+        enum Side
+        {
+            Left,
+            Right,
+            Bottom,
+            Top,
+            Near,
+            Far,
+            SideCount
+        };
+
+        Plane planes[SideCount];
+
+        constexpr Frustum() = default;
+        // Extracts the planes of the clip volume of viewProjection, using the [0, 1] depth range of
+        // Matrix4x4::Perspective and Matrix4x4::Orthographic.
+        explicit Frustum(const Matrix4x4& viewProjection)
+        {
+            const Vector4 x = viewProjection.GetRow(0);
+            const Vector4 y = viewProjection.GetRow(1);
+            const Vector4 z = viewProjection.GetRow(2);
+            const Vector4 w = viewProjection.GetRow(3);
+            planes[Left] = Normalized(w + x);
+            planes[Right] = Normalized(w - x);
+            planes[Bottom] = Normalized(w + y);
+            planes[Top] = Normalized(w - y);
+            planes[Near] = Normalized(z);
+            planes[Far] = Normalized(w - z);
+        }
+
+        // The volume hidden behind the convex quad a, b, c, d as seen from eye; its Far plane never culls.
+        static Frustum FromOccluder(const Vector3& eye, const Vector3& a, const Vector3& b, const Vector3& c, const Vector3& d)
+        {
+            const Vector3 center = (a + b + c + d) * 0.25f;
+            const Plane edges[] = {Plane(eye, a, b), Plane(eye, b, c), Plane(eye, c, d), Plane(eye, d, a)};
+            const Plane quad(a, b, c);
+
+            Frustum frustum;
+            for(int side = Left; side <= Top; side++)
+            {
+                frustum.planes[side] = edges[side].GetDistanceToPoint(center) < 0 ? edges[side].Flipped() : edges[side];
+            }
+            frustum.planes[Near] = quad.GetDistanceToPoint(eye) > 0 ? quad.Flipped() : quad;
+            frustum.planes[Far] = Plane(Vector3::Zero(), std::numeric_limits<float>::max());
+            return frustum;
+        }
+
+        constexpr bool Contains(const Vector3& point) const
+        {
+            for(const Plane& plane : planes)
+            {
+                if(plane.GetDistanceToPoint(point) < 0) return false;
+            }
+            return true;
+        }
+        constexpr bool Contains(const Sphere& sphere) const
+        {
+            for(const Plane& plane : planes)
+            {
+                if(plane.GetDistanceToPoint(sphere.center) < sphere.radius) return false;
+            }
+            return true;
+        }
+        constexpr bool Contains(const AABB& box) const
+        {
+            const Vector3 center = box.Center();
+            const Vector3 extents = box.Extents();
+            for(const Plane& plane : planes)
+            {
+                if(plane.GetDistanceToPoint(center) < Reach(plane, extents)) return false;
+            }
+            return true;
+        }
+
+        constexpr bool Intersects(const Sphere& sphere) const
+        {
+            for(const Plane& plane : planes)
+            {
+                if(plane.GetDistanceToPoint(sphere.center) < -sphere.radius) return false;
+            }
+            return true;
+        }
+        constexpr bool Intersects(const AABB& box) const
+        {
+            const Vector3 center = box.Center();
+            const Vector3 extents = box.Extents();
+            for(const Plane& plane : planes)
+            {
+                if(plane.GetDistanceToPoint(center) < -Reach(plane, extents)) return false;
+            }
+            return true;
+        }
+
+    private:
+        static Plane Normalized(const Vector4& coefficients)
+        {
+            const Vector3 normal(coefficients.x, coefficients.y, coefficients.z);
+            const float inverseLength = 1.0f / normal.Magnitude();
+            return {normal * inverseLength, coefficients.w * inverseLength};
+        }
+
+        // How far a box with these extents reaches along the plane normal.
+        static constexpr float Reach(const Plane& plane, const Vector3& extents)
+        {
+            return Abs(plane.normal.x) * extents.x + Abs(plane.normal.y) * extents.y + Abs(plane.normal.z) * extents.z;
+        }
+    };
+}
@@ -0,0 +1,225 @@
+﻿#include "GeometryBatch.hpp"
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "WMath/Simd.hpp"
+
+namespace
+{
+    typedef WMath::Simd::NativeLanes Lanes;
+    typedef Lanes::Float Float;
+
+    struct Vector3Lanes
+    {
+        Float x;
+        Float y;
+        Float z;
+    };
+
+    Vector3Lanes Sub(const Vector3Lanes& a, const Vector3Lanes& b)
+    {
+        return {Lanes::Sub(a.x, b.x), Lanes::Sub(a.y, b.y), Lanes::Sub(a.z, b.z)};
+    }
+
+    Float Dot(const Vector3Lanes& a, const Vector3Lanes& b)
+    {
+        return Lanes::Add(Lanes::Add(Lanes::Mul(a.x, b.x), Lanes::Mul(a.y, b.y)), Lanes::Mul(a.z, b.z));
+    }
+
+    Vector3Lanes Cross(const Vector3Lanes& a, const Vector3Lanes& b)
+    {
+        return {Lanes::Sub(Lanes::Mul(a.y, b.z), Lanes::Mul(a.z, b.y)),
+            Lanes::Sub(Lanes::Mul(a.z, b.x), Lanes::Mul(a.x, b.z)),
+            Lanes::Sub(Lanes::Mul(a.x, b.y), Lanes::Mul(a.y, b.x))};
+    }
+
+    Lanes::Mask GreaterEqual(Float a, Float b)
+    {
+        return Lanes::LessEqual(b, a);
+    }
+
+    // Every primitive is a packed struct of floats, so a packet is just its components transposed into lanes.
+    template<typename T>
+    struct Packet
+    {
+        static constexpr std::size_t Components = sizeof(T) / sizeof(float);
+        typedef std::array<float, Components> Floats;
+        static_assert(sizeof(T) == sizeof(Floats));
+
+        Float values[Components];
+
+        static Packet Load(const T* items, std::size_t count)
+        {
+            Packet packet;
+            WMath::Simd::LoadTransposed<Lanes>(reinterpret_cast<const float*>(items), count, packet.values);
+            return packet;
+        }
+        static Packet Broadcast(const T& item)
+        {
+            const Floats floats = std::bit_cast<Floats>(item);
+            Packet packet;
+            for(std::size_t component = 0; component < Components; component++) packet.values[component] = Lanes::Set(floats[component]);
+            return packet;
+        }
+
+        Vector3Lanes GetVector3(std::size_t first) const
+        {
+            return {values[first], values[first + 1], values[first + 2]};
+        }
+    };
+
+    Float Miss(Lanes::Mask hit, Float distance)
+    {
+        return Lanes::Select(hit, distance, Lanes::Set(std::numeric_limits<float>::infinity()));
+    }
+
+    Float Raycast(const Packet<WMath::Ray>& ray, const Packet<WMath::AABB>& box)
+    {
+        const Vector3Lanes origin = ray.GetVector3(0);
+        const Vector3Lanes direction = ray.GetVector3(3);
+        const Vector3Lanes min = box.GetVector3(0);
+        const Vector3Lanes max = box.GetVector3(3);
+
+        const Float one = Lanes::Set(1.0f);
+        Float enter = Lanes::Set(0.0f);
+        Float exit = Lanes::Set(std::numeric_limits<float>::infinity());
+        const auto slab = [&](Float origin, Float direction, Float min, Float max)
+        {
+            const Float inverseDirection = Lanes::Div(one, direction);
+            const Float first = Lanes::Mul(Lanes::Sub(min, origin), inverseDirection);
+            const Float second = Lanes::Mul(Lanes::Sub(max, origin), inverseDirection);
+            enter = Lanes::Max(enter, Lanes::Min(first, second));
+            exit = Lanes::Min(exit, Lanes::Max(first, second));
+        };
+        slab(origin.x, direction.x, min.x, max.x);
+        slab(origin.y, direction.y, min.y, max.y);
+        slab(origin.z, direction.z, min.z, max.z);
+
+        return Miss(Lanes::LessEqual(enter, exit), enter);
+    }
+
+    Float Raycast(const Packet<WMath::Ray>& ray, const Packet<WMath::Plane>& plane)
+    {
+        const Vector3Lanes normal = plane.GetVector3(0);
+        const Float approach = Dot(normal, ray.GetVector3(3));
+        const Float distance = Lanes::Add(Dot(normal, ray.GetVector3(0)), plane.values[3]);
+        const Float enter = Lanes::Div(Lanes::Sub(Lanes::Set(0.0f), distance), approach);
+
+        // A parallel ray divides by zero, giving an infinite or NaN distance that both comparisons reject.
+        const Lanes::Mask hit = Lanes::And(GreaterEqual(enter, Lanes::Set(0.0f)), Lanes::Less(enter, Lanes::Set(std::numeric_limits<float>::infinity())));
+        return Miss(hit, enter);
+    }
+
+    Float Raycast(const Packet<WMath::Ray>& ray, const Packet<WMath::Sphere>& sphere)
+    {
+        const Vector3Lanes offset = Sub(ray.GetVector3(0), sphere.GetVector3(0));
+        const Float radius = sphere.values[3];
+        const Float b = Dot(offset, ray.GetVector3(3));
+        const Float c = Lanes::Sub(Dot(offset, offset), Lanes::Mul(radius, radius));
+        const Float discriminant = Lanes::Sub(Lanes::Mul(b, b), c);
+        const Float root = Lanes::Sqrt(Lanes::Max(discriminant, Lanes::Set(0.0f)));
+
+        const Lanes::Mask hit = Lanes::And(GreaterEqual(discriminant, Lanes::Set(0.0f)), GreaterEqual(root, b));
+        return Miss(hit, Lanes::Max(Lanes::Sub(Lanes::Sub(Lanes::Set(0.0f), b), root), Lanes::Set(0.0f)));
+    }
+
+    Float Raycast(const Packet<WMath::Ray>& ray, const Packet<WMath::Triangle>& triangle)
+    {
+        const Vector3Lanes origin = ray.GetVector3(0);
+        const Vector3Lanes direction = ray.GetVector3(3);
+        const Vector3Lanes a = triangle.GetVector3(0);
+        const Vector3Lanes edge1 = Sub(triangle.GetVector3(3), a);
+        const Vector3Lanes edge2 = Sub(triangle.GetVector3(6), a);
+
+        // A zero determinant makes the inverse infinite, so u, v and the distance become infinite or NaN and fail the
+        // range checks below.
+        const Vector3Lanes p = Cross(direction, edge2);
+        const Float inverseDeterminant = Lanes::Div(Lanes::Set(1.0f), Dot(edge1, p));
+        const Vector3Lanes offset = Sub(origin, a);
+        const Float u = Lanes::Mul(Dot(offset, p), inverseDeterminant);
+        const Vector3Lanes q = Cross(offset, edge1);
+        const Float v = Lanes::Mul(Dot(direction, q), inverseDeterminant);
+        const Float enter = Lanes::Mul(Dot(edge2, q), inverseDeterminant);
+
+        const Float zero = Lanes::Set(0.0f);
+        const Float one = Lanes::Set(1.0f);
+        Lanes::Mask hit = Lanes::And(GreaterEqual(u, zero), Lanes::LessEqual(u, one));
+        hit = Lanes::And(hit, Lanes::And(GreaterEqual(v, zero), Lanes::LessEqual(Lanes::Add(u, v), one)));
+        hit = Lanes::And(hit, Lanes::And(GreaterEqual(enter, zero), Lanes::Less(enter, Lanes::Set(std::numeric_limits<float>::infinity()))));
+        return Miss(hit, enter);
+    }
+
+    template<typename T, typename Kernel>
+    void Map(std::span<const T> items, std::span<float> out, Kernel kernel)
+    {
+        assert(out.size() >= items.size());
+
+        const std::size_t count = items.size();
+        std::size_t i = 0;
+        for(; i + Lanes::Width <= count; i += Lanes::Width) Lanes::Store(out.data() + i, kernel(Packet<T>::Load(items.data() + i, Lanes::Width)));
+        if(i == count) return;
+
+        float padded[Lanes::Width];
+        Lanes::Store(padded, kernel(Packet<T>::Load(items.data() + i, count - i)));
+        for(std::size_t lane = 0; i + lane < count; lane++) out[i + lane] = padded[lane];
+    }
+
+    template<typename T>
+    void RaycastRays(std::span<const WMath::Ray> rays, const T& primitive, std::span<float> distances)
+    {
+        const Packet<T> packet = Packet<T>::Broadcast(primitive);
+        Map(rays, distances, [&](const Packet<WMath::Ray>& ray) { return Raycast(ray, packet); });
+    }
+
+    template<typename T>
+    void RaycastPrimitives(const WMath::Ray& ray, std::span<const T> primitives, std::span<float> distances)
+    {
+        const Packet<WMath::Ray> packet = Packet<WMath::Ray>::Broadcast(ray);
+        Map(primitives, distances, [&](const Packet<T>& primitive) { return Raycast(packet, primitive); });
+    }
+}
+
+void WMath::Batch::Raycast(std::span<const Ray> rays, const AABB& box, std::span<float> distances)
+{
+    RaycastRays(rays, box, distances);
+}
+
+void WMath::Batch::Raycast(std::span<const Ray> rays, const Plane& plane, std::span<float> distances)
+{
+    RaycastRays(rays, plane, distances);
+}
+
+void WMath::Batch::Raycast(std::span<const Ray> rays, const Sphere& sphere, std::span<float> distances)
+{
+    RaycastRays(rays, sphere, distances);
+}
+
+void WMath::Batch::Raycast(std::span<const Ray> rays, const Triangle& triangle, std::span<float> distances)
+{
+    RaycastRays(rays, triangle, distances);
+}
+
+void WMath::Batch::Raycast(const Ray& ray, std::span<const AABB> boxes, std::span<float> distances)
+{
+    RaycastPrimitives(ray, boxes, distances);
+}
+
+void WMath::Batch::Raycast(const Ray& ray, std::span<const Plane> planes, std::span<float> distances)
+{
+    RaycastPrimitives(ray, planes, distances);
+}
+
+void WMath::Batch::Raycast(const Ray& ray, std::span<const Sphere> spheres, std::span<float> distances)
+{
+    RaycastPrimitives(ray, spheres, distances);
+}
+
+void WMath::Batch::Raycast(const Ray& ray, std::span<const Triangle> triangles, std::span<float> distances)
+{
+    RaycastPrimitives(ray, triangles, distances);
+}
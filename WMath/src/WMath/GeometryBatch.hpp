@@ -0,0 +1,25 @@
+﻿#pragma once
+
+#include <span>
+#include "WMath/AABB.hpp"
+#include "WMath/Plane.hpp"
+#include "WMath/Ray.hpp"
+#include "WMath/Sphere.hpp"
+#include "WMath/Triangle.hpp"
+
+namespace WMath::Batch
+{
+    // Packet versions of the primitives' Raycast functions, testing Simd::NativeLanes rays against one primitive or
+    // one ray against as many primitives at a time. distances receives the hit distance of each element, or infinity
+    // where it misses, and matches the scalar Raycast up to rounding.
+
+    void Raycast(std::span<const Ray> rays, const AABB& box, std::span<float> distances);
+    void Raycast(std::span<const Ray> rays, const Plane& plane, std::span<float> distances);
+    void Raycast(std::span<const Ray> rays, const Sphere& sphere, std::span<float> distances);
+    void Raycast(std::span<const Ray> rays, const Triangle& triangle, std::span<float> distances);
+
+    void Raycast(const Ray& ray, std::span<const AABB> boxes, std::span<float> distances);
+    void Raycast(const Ray& ray, std::span<const Plane> planes, std::span<float> distances);
+    void Raycast(const Ray& ray, std::span<const Sphere> spheres, std::span<float> distances);
+    void Raycast(const Ray& ray, std::span<const Triangle> triangles, std::span<float> distances);
+}
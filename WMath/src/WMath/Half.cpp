@@ -0,0 +1,64 @@
+﻿#include "Half.hpp"
+
+#include <cassert>
+#include <cstddef>
+
+void WMath::ToHalf(std::span<const float> values, std::span<Half> out)
+{
+    assert(out.size() >= values.size());
+    const std::size_t count = values.size();
+    const float* in = values.data();
+    std::size_t i = 0;
+#if defined(WMATH_AVX512)
+    for(; i + 16 <= count; i += 16)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.data() + i), _mm512_cvtps_ph(_mm512_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+    }
+#endif
+#if defined(WMATH_F16C)
+    for(; i + 8 <= count; i += 8)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+    }
+#endif
+    for(; i < count; i++) out[i] = Half(in[i]);
+}
+
+void WMath::ToBFloat16(std::span<const float> values, std::span<BFloat16> out)
+{
+    assert(out.size() >= values.size());
+    const std::size_t count = values.size();
+    const float* in = values.data();
+    BFloat16* result = out.data();
+    for(std::size_t i = 0; i < count; i++) result[i] = BFloat16(in[i]);
+}
+
+void WMath::ToFloat(std::span<const Half> values, std::span<float> out)
+{
+    assert(out.size() >= values.size());
+    const std::size_t count = values.size();
+    float* result = out.data();
+    std::size_t i = 0;
+#if defined(WMATH_AVX512)
+    for(; i + 16 <= count; i += 16)
+    {
+        _mm512_storeu_ps(result + i, _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values.data() + i))));
+    }
+#endif
+#if defined(WMATH_F16C)
+    for(; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(result + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values.data() + i))));
+    }
+#endif
+    for(; i < count; i++) result[i] = values[i];
+}
+
+void WMath::ToFloat(std::span<const BFloat16> values, std::span<float> out)
+{
+    assert(out.size() >= values.size());
+    const std::size_t count = values.size();
+    const BFloat16* in = values.data();
+    float* result = out.data();
+    for(std::size_t i = 0; i < count; i++) result[i] = in[i];
+}
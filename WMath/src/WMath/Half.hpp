@@ -0,0 +1,208 @@
+﻿#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include "WMath/Simd.hpp"
+#include "WMath/Vector.hpp"
+
+namespace WMath
+{
+    // IEEE 754 binary16: 1 sign, 5 exponent and 10 mantissa bits, so about 3 decimal digits over [6.1e-5, 65504] plus
+    // subnormals down to 6.0e-8. Converting from float rounds to nearest even; values from 65520 up become infinity and
+    // NaNs stay NaN. Converting back to float is exact except that signalling NaNs come back quiet, as F16C does. Half
+    // is a storage type only; do the arithmetic in float.
+    class Half
+    {
+    public:
+        constexpr Half() = default;
+        constexpr explicit Half(float value) : bits(FromFloat(value)) {}
+
+        static constexpr Half FromBits(std::uint16_t bits)
+        {
+            Half half;
+            half.bits = bits;
+            return half;
+        }
+
+        constexpr std::uint16_t GetBits() const
+        {
+            return bits;
+        }
+
+        constexpr operator float() const
+        {
+            return ToFloat(bits);
+        }
+
+    private:
+        std::uint16_t bits = 0;
+
+        static constexpr std::uint16_t FromFloat(float value)
+        {
+#if defined(WMATH_F16C)
+            if(!std::is_constant_evaluated()) return static_cast<std::uint16_t>(_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+#endif
+            std::uint32_t magnitude = std::bit_cast<std::uint32_t>(value);
+            const std::uint32_t sign = magnitude >> 16 & 0x8000u;
+            magnitude &= 0x7FFFFFFFu;
+
+            // All three cases are computed and masked together, without branches, so that span conversions vectorize
+            // without F16C. For subnormals, adding 0.5 lines the mantissa up with the float's low bits and the FPU
+            // rounds it to even.
+            const std::uint32_t special = 0x7C00u | ((0u - (magnitude > 0x7F800000u)) & (0x200u | (magnitude >> 13 & 0x3FFu)));
+            const std::uint32_t subnormal = std::bit_cast<std::uint32_t>(std::bit_cast<float>(magnitude) + 0.5f) - 0x3F000000u;
+            const std::uint32_t normal = (magnitude - 0x38000000u + 0xFFFu + (magnitude >> 13 & 1u)) >> 13;
+            const std::uint32_t isSpecial = 0u - (magnitude >= 0x47800000u);
+            const std::uint32_t isSubnormal = ~isSpecial & (0u - (magnitude < 0x38800000u));
+            const std::uint32_t result = (special & isSpecial) | (subnormal & isSubnormal) | (normal & ~(isSpecial | isSubnormal));
+            return static_cast<std::uint16_t>(result | sign);
+        }
+
+        static constexpr float ToFloat(std::uint16_t bits)
+        {
+#if defined(WMATH_F16C)
+            if(!std::is_constant_evaluated()) return _cvtsh_ss(bits);
+#endif
+            const std::uint32_t sign = static_cast<std::uint32_t>(bits & 0x8000u) << 16;
+            const std::uint32_t shifted = static_cast<std::uint32_t>(bits & 0x7FFFu) << 13;
+            const std::uint32_t exponent = shifted & 0x0F800000u;
+
+            // Subnormals are normalized by the FPU: subtract the implicit one back out of 2^-14 * 1.mantissa. NaNs get
+            // the quiet bit set.
+            const std::uint32_t normal = shifted + (exponent == 0x0F800000u ? 0x70000000u : 0x38000000u);
+            const std::uint32_t subnormal = std::bit_cast<std::uint32_t>(std::bit_cast<float>(shifted + 0x38800000u) - 6.103515625e-05f);
+            const std::uint32_t quiet = (0u - (shifted > 0x0F800000u)) & 0x00400000u;
+            const std::uint32_t isSubnormal = 0u - (exponent == 0);
+            return std::bit_cast<float>((subnormal & isSubnormal) | (normal & ~isSubnormal) | quiet | sign);
+        }
+    };
+
+    // bfloat16: the upper half of a float, so it keeps the full float range with 8 mantissa bits, about 2 to 3 decimal
+    // digits. Converting from float rounds to nearest even and keeps NaNs quiet; converting back is exact.
+    class BFloat16
+    {
+    public:
+        constexpr BFloat16() = default;
+        constexpr explicit BFloat16(float value) : bits(FromFloat(value)) {}
+
+        static constexpr BFloat16 FromBits(std::uint16_t bits)
+        {
+            BFloat16 bfloat;
+            bfloat.bits = bits;
+            return bfloat;
+        }
+
+        constexpr std::uint16_t GetBits() const
+        {
+            return bits;
+        }
+
+        constexpr operator float() const
+        {
+            return std::bit_cast<float>(static_cast<std::uint32_t>(bits) << 16);
+        }
+
+    private:
+        std::uint16_t bits = 0;
+
+        static constexpr std::uint16_t FromFloat(float value)
+        {
+            const std::uint32_t word = std::bit_cast<std::uint32_t>(value);
+            if((word & 0x7FFFFFFFu) > 0x7F800000u) return static_cast<std::uint16_t>(word >> 16 | 0x40u);
+            return static_cast<std::uint16_t>((word + 0x7FFFu + (word >> 16 & 1u)) >> 16);
+        }
+    };
+
+    static_assert(sizeof(Half) == 2 && sizeof(BFloat16) == 2);
+
+    // Packed 2 or 3 component storage over Half or BFloat16, half the size of the float vector it converts to and from.
+    // Keep large vertex, normal and texture coordinate buffers in these and widen them to Vector2/Vector3 for math.
+    template<int N, typename S>
+    struct PackedVector : VectorStorage<N, S>
+    {
+        static_assert(N == 2 || N == 3, "PackedVector supports 2 and 3 components");
+        static_assert(std::is_same_v<S, Half> || std::is_same_v<S, BFloat16>, "PackedVector supports Half and BFloat16 components");
+
+        typedef S ValueType;
+        typedef Vector<N, float> FloatVector;
+
+        constexpr PackedVector() = default;
+        constexpr PackedVector(S x, S y) requires(N == 2) : VectorStorage<N, S>{x, y} {}
+        constexpr PackedVector(S x, S y, S z) requires(N == 3) : VectorStorage<N, S>{x, y, z} {}
+        constexpr explicit PackedVector(const FloatVector& vector) requires(N == 2) : PackedVector(S(vector.x), S(vector.y)) {}
+        constexpr explicit PackedVector(const FloatVector& vector) requires(N == 3) : PackedVector(S(vector.x), S(vector.y), S(vector.z)) {}
+
+        constexpr FloatVector ToVector() const
+        {
+            if constexpr(N == 2) return FloatVector(this->x, this->y);
+            else return FloatVector(this->x, this->y, this->z);
+        }
+        constexpr operator FloatVector() const
+        {
+            return ToVector();
+        }
+    };
+
+    typedef PackedVector<2, Half> Vector2h;
+    typedef PackedVector<3, Half> Vector3h;
+    typedef PackedVector<2, BFloat16> Vector2bf;
+    typedef PackedVector<3, BFloat16> Vector3bf;
+
+    static_assert(sizeof(Vector2h) == 4 && sizeof(Vector3h) == 6 && sizeof(Vector2bf) == 4 && sizeof(Vector3bf) == 6);
+
+    // Span conversions, 8 or 16 values at a time with F16C or AVX-512 and with the scalar bit operations above
+    // otherwise; the results match the scalar constructors exactly. Outputs must not overlap the inputs.
+    void ToHalf(std::span<const float> values, std::span<Half> out);
+    void ToBFloat16(std::span<const float> values, std::span<BFloat16> out);
+    void ToFloat(std::span<const Half> values, std::span<float> out);
+    void ToFloat(std::span<const BFloat16> values, std::span<float> out);
+
+    namespace Detail
+    {
+        template<typename P>
+        std::span<const typename P::ValueType> PackedComponents(std::span<const P> vectors)
+        {
+            return {reinterpret_cast<const typename P::ValueType*>(vectors.data()), vectors.size() * sizeof(P) / sizeof(typename P::ValueType)};
+        }
+        template<typename P>
+        std::span<typename P::ValueType> PackedComponents(std::span<P> vectors)
+        {
+            return {reinterpret_cast<typename P::ValueType*>(vectors.data()), vectors.size() * sizeof(P) / sizeof(typename P::ValueType)};
+        }
+    }
+
+    inline void ToHalf(std::span<const Vector2> vectors, std::span<Vector2h> out)
+    {
+        ToHalf(Detail::PackedComponents(vectors), Detail::PackedComponents(out));
+    }
+    inline void ToHalf(std::span<const Vector3> vectors, std::span<Vector3h> out)
+    {
+        ToHalf(Detail::PackedComponents(vectors), Detail::PackedComponents(out));
+    }
+    inline void ToBFloat16(std::span<const Vector2> vectors, std::span<Vector2bf> out)
+    {
+        ToBFloat16(Detail::PackedComponents(vectors), Detail::PackedComponents(out));
+    }
+    inline void ToBFloat16(std::span<const Vector3> vectors, std::span<Vector3bf> out)
+    {
+        ToBFloat16(Detail::PackedComponents(vectors), Detail::PackedComponents(out));
+    }
+    inline void ToFloat(std::span<const Vector2h> vectors, std::span<Vector2> out)
+    {
+        ToFloat(Detail::PackedComponents(vectors), Detail::PackedComponents(out));
+    }
+    inline void ToFloat(std::span<const Vector3h> vectors, std::span<Vector3> out)
+    {
+        ToFloat(Detail::PackedComponents(vectors), Detail::PackedComponents(out));
+    }
+    inline void ToFloat(std::span<const Vector2bf> vectors, std::span<Vector2> out)
+    {
+        ToFloat(Detail::PackedComponents(vectors), Detail::PackedComponents(out));
+    }
+    inline void ToFloat(std::span<const Vector3bf> vectors, std::span<Vector3> out)
+    {
+        ToFloat(Detail::PackedComponents(vectors), Detail::PackedComponents(out));
+    }
+}
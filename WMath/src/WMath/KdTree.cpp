@@ -0,0 +1,301 @@
+﻿#include "KdTree.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+#include "WMath/Parallel.hpp"
+
+struct WMath::KdTree::BuildEntry
+{
+    Vector3 point;
+    std::uint32_t index;
+};
+
+namespace
+{
+    // Deep enough for any tree over fewer than 2^32 points, since splits always halve the range.
+    constexpr int MaxStackDepth = 64;
+    // Parallel builds stop splitting off subtrees below this many points or beyond this many subtrees.
+    constexpr std::uint32_t ParallelBuildThreshold = 16384;
+    constexpr std::size_t MaxParallelSubtrees = 64;
+    constexpr std::size_t QueryGrainSize = 64;
+
+    float& Component(WMath::Vector3& vector, std::uint32_t axis)
+    {
+        return axis == 0 ? vector.x : axis == 1 ? vector.y : vector.z;
+    }
+
+    float Component(const WMath::Vector3& vector, std::uint32_t axis)
+    {
+        return axis == 0 ? vector.x : axis == 1 ? vector.y : vector.z;
+    }
+
+    std::uint32_t NodeCount(std::uint32_t count)
+    {
+        if(count <= WMath::KdTree::LeafSize) return 1;
+        return 1 + NodeCount(count / 2) + NodeCount(count - count / 2);
+    }
+
+    bool CloserThan(const WMath::KdTree::Neighbor& lhs, const WMath::KdTree::Neighbor& rhs)
+    {
+        return lhs.distanceSquared < rhs.distanceSquared;
+    }
+
+    template<typename Function>
+    void ForEachQuery(std::size_t count, unsigned threadCount, const Function& function)
+    {
+        WMath::Parallel::For(count, threadCount, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t i = begin; i < end; i++) function(i);
+        }, QueryGrainSize);
+    }
+}
+
+void WMath::KdTree::Build(std::span<const Vector3> source, unsigned threadCount)
+{
+    Clear();
+    if(source.empty()) return;
+    assert(source.size() < InvalidIndex);
+
+    const std::uint32_t count = static_cast<std::uint32_t>(source.size());
+    std::vector<BuildEntry> entries(count);
+    for(std::uint32_t i = 0; i < count; i++) entries[i] = {source[i], i};
+
+    nodes.resize(NodeCount(count));
+
+    // Median splits give every subtree on a level the same size. The top levels are split one level at a time, each
+    // level's splits running in parallel, and the resulting subtrees are then built as independent tasks.
+    struct Subtree
+    {
+        std::uint32_t node;
+        std::uint32_t begin;
+        std::uint32_t end;
+    };
+    std::array<Subtree, MaxParallelSubtrees> subtrees;
+    subtrees[0] = {0, 0, count};
+    std::size_t subtreeCount = 1;
+
+    const std::size_t targetCount = threadCount == 1 ? 1 :
+        std::min(MaxParallelSubtrees, Parallel::ChunkCount(threadCount));
+    while(subtreeCount * 2 <= targetCount && subtrees[0].end - subtrees[0].begin >= ParallelBuildThreshold)
+    {
+        std::array<Subtree, MaxParallelSubtrees> children;
+        ThreadPool::Global().For(subtreeCount, 1, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t i = begin; i < end; i++)
+            {
+                const Subtree& subtree = subtrees[i];
+                const std::uint32_t middle = SplitNode(subtree.node, entries.data(), subtree.begin, subtree.end);
+                children[2 * i] = {subtree.node + 1, subtree.begin, middle};
+                children[2 * i + 1] = {nodes[subtree.node].second, middle, subtree.end};
+            }
+        });
+        subtrees = children;
+        subtreeCount *= 2;
+    }
+
+    if(subtreeCount == 1) BuildNode(0, entries.data(), 0, count);
+    else ThreadPool::Global().For(subtreeCount, 1, [&](std::size_t begin, std::size_t end)
+    {
+        for(std::size_t i = begin; i < end; i++) BuildNode(subtrees[i].node, entries.data(), subtrees[i].begin, subtrees[i].end);
+    });
+
+    points.resize(count);
+    indices.resize(count);
+    for(std::uint32_t i = 0; i < count; i++)
+    {
+        points[i] = entries[i].point;
+        indices[i] = entries[i].index;
+    }
+}
+
+void WMath::KdTree::Clear()
+{
+    nodes.clear();
+    points.clear();
+    indices.clear();
+}
+
+std::uint32_t WMath::KdTree::Nearest(const Vector3& point) const
+{
+    Neighbor nearest;
+    return KNearest(point, {&nearest, 1}) == 0 ? InvalidIndex : nearest.index;
+}
+
+std::size_t WMath::KdTree::KNearest(const Vector3& point, std::span<Neighbor> out) const
+{
+    const std::size_t k = out.size();
+    if(k == 0 || Empty()) return 0;
+
+    struct StackEntry
+    {
+        std::uint32_t node;
+        float bound;
+        Vector3 offset;
+    };
+    StackEntry stack[MaxStackDepth];
+    int top = 0;
+    stack[top++] = {0, 0.0f, Vector3()};
+
+    // out[0, found) is a max-heap on distance, so the current worst candidate is always out[0].
+    std::size_t found = 0;
+    float worst = std::numeric_limits<float>::infinity();
+    while(top > 0)
+    {
+        StackEntry entry = stack[--top];
+        if(entry.bound >= worst) continue;
+
+        std::uint32_t node = entry.node;
+        while(nodes[node].axis != LeafAxis)
+        {
+            const Node& interior = nodes[node];
+            const float difference = Component(point, interior.axis) - interior.split;
+            const std::uint32_t near = difference < 0 ? node + 1 : interior.second;
+            const std::uint32_t far = difference < 0 ? interior.second : node + 1;
+
+            // The far cell is at least |difference| away along the split axis, which replaces that axis' previous
+            // contribution to the lower bound.
+            const float offset = Component(entry.offset, interior.axis);
+            const float farBound = entry.bound - offset * offset + difference * difference;
+            if(farBound < worst)
+            {
+                assert(top < MaxStackDepth);
+                stack[top] = {far, farBound, entry.offset};
+                Component(stack[top].offset, interior.axis) = difference;
+                top++;
+            }
+            node = near;
+        }
+
+        const Node& leaf = nodes[node];
+        for(std::uint32_t i = leaf.first; i < leaf.second; i++)
+        {
+            const float distanceSquared = (points[i] - point).MagnitudeSquared();
+            if(found < k)
+            {
+                out[found++] = {indices[i], distanceSquared};
+                std::push_heap(out.begin(), out.begin() + found, CloserThan);
+                if(found == k) worst = out[0].distanceSquared;
+            }
+            else if(distanceSquared < worst)
+            {
+                std::pop_heap(out.begin(), out.end(), CloserThan);
+                out[k - 1] = {indices[i], distanceSquared};
+                std::push_heap(out.begin(), out.end(), CloserThan);
+                worst = out[0].distanceSquared;
+            }
+        }
+    }
+
+    std::sort_heap(out.begin(), out.begin() + found, CloserThan);
+    return found;
+}
+
+void WMath::KdTree::Radius(const Vector3& center, float radius, std::vector<std::uint32_t>& out) const
+{
+    if(Empty() || radius < 0) return;
+
+    const float radiusSquared = radius * radius;
+    std::uint32_t stack[MaxStackDepth];
+    int top = 0;
+    stack[top++] = 0;
+    while(top > 0)
+    {
+        const Node& node = nodes[stack[--top]];
+        if(node.axis == LeafAxis)
+        {
+            for(std::uint32_t i = node.first; i < node.second; i++)
+            {
+                if((points[i] - center).MagnitudeSquared() <= radiusSquared) out.push_back(indices[i]);
+            }
+            continue;
+        }
+
+        const std::uint32_t self = static_cast<std::uint32_t>(&node - nodes.data());
+        const float difference = Component(center, node.axis) - node.split;
+        if(difference <= radius) stack[top++] = self + 1;
+        if(difference >= -radius) stack[top++] = node.second;
+    }
+}
+
+void WMath::KdTree::Box(const Vector3& min, const Vector3& max, std::vector<std::uint32_t>& out) const
+{
+    if(Empty()) return;
+
+    std::uint32_t stack[MaxStackDepth];
+    int top = 0;
+    stack[top++] = 0;
+    while(top > 0)
+    {
+        const Node& node = nodes[stack[--top]];
+        if(node.axis == LeafAxis)
+        {
+            for(std::uint32_t i = node.first; i < node.second; i++)
+            {
+                const Vector3& point = points[i];
+                if(point.x >= min.x && point.y >= min.y && point.z >= min.z &&
+                    point.x <= max.x && point.y <= max.y && point.z <= max.z) out.push_back(indices[i]);
+            }
+            continue;
+        }
+
+        const std::uint32_t self = static_cast<std::uint32_t>(&node - nodes.data());
+        if(Component(min, node.axis) <= node.split) stack[top++] = self + 1;
+        if(Component(max, node.axis) >= node.split) stack[top++] = node.second;
+    }
+}
+
+void WMath::KdTree::Nearest(std::span<const Vector3> queries, std::span<std::uint32_t> out, unsigned threadCount) const
+{
+    assert(out.size() >= queries.size());
+    ForEachQuery(queries.size(), threadCount, [&](std::size_t i) { out[i] = Nearest(queries[i]); });
+}
+
+void WMath::KdTree::KNearest(std::span<const Vector3> queries, std::size_t k, std::span<Neighbor> out, unsigned threadCount) const
+{
+    assert(out.size() >= queries.size() * k);
+    ForEachQuery(queries.size(), threadCount, [&](std::size_t i)
+    {
+        const std::span<Neighbor> row = out.subspan(i * k, k);
+        const std::size_t found = KNearest(queries[i], row);
+        for(std::size_t j = found; j < k; j++) row[j] = {InvalidIndex, std::numeric_limits<float>::infinity()};
+    });
+}
+
+void WMath::KdTree::BuildNode(std::uint32_t node, BuildEntry* entries, std::uint32_t begin, std::uint32_t end)
+{
+    if(end - begin <= LeafSize)
+    {
+        nodes[node] = {0.0f, LeafAxis, begin, end};
+        return;
+    }
+
+    const std::uint32_t middle = SplitNode(node, entries, begin, end);
+    BuildNode(node + 1, entries, begin, middle);
+    BuildNode(nodes[node].second, entries, middle, end);
+}
+
+std::uint32_t WMath::KdTree::SplitNode(std::uint32_t node, BuildEntry* entries, std::uint32_t begin, std::uint32_t end)
+{
+    Vector3 min = entries[begin].point;
+    Vector3 max = min;
+    for(std::uint32_t i = begin + 1; i < end; i++)
+    {
+        min = Vector3::Min(min, entries[i].point);
+        max = Vector3::Max(max, entries[i].point);
+    }
+    const Vector3 extent = max - min;
+    const std::uint32_t axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : extent.y >= extent.z ? 1 : 2;
+
+    // Splitting at the median by count fixes the shape of both subtrees up front, so the right child's slot is known
+    // before the left subtree is built and the two halves can be built independently.
+    const std::uint32_t middle = begin + (end - begin) / 2;
+    std::nth_element(entries + begin, entries + middle, entries + end, [axis](const BuildEntry& lhs, const BuildEntry& rhs)
+    {
+        return Component(lhs.point, axis) < Component(rhs.point, axis);
+    });
+
+    nodes[node] = {Component(entries[middle].point, axis), axis, begin, node + 1 + NodeCount(middle - begin)};
+    return middle;
+}
@@ -0,0 +1,80 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include "WMath/Vector3.hpp"
+
+namespace WMath
+{
+    // Static k-d tree over a point set. Nodes are stored depth first in one array with the left child directly after
+    // its parent, and the points are copied into leaf order so every leaf scans a contiguous range. All queries are
+    // const and keep no shared state, so any number of threads may query the same tree concurrently.
+    class KdTree
+    {
+    public:
+        static constexpr std::uint32_t InvalidIndex = std::numeric_limits<std::uint32_t>::max();
+        static constexpr std::uint32_t LeafSize = 8;
+
+        struct Neighbor
+        {
+            std::uint32_t index;
+            float distanceSquared;
+        };
+
+        KdTree() = default;
+        explicit KdTree(std::span<const Vector3> points, unsigned threadCount = 1)
+        {
+            Build(points, threadCount);
+        }
+
+        // Indices returned by the queries refer to positions in the span passed here. A threadCount other than 1 runs on
+        // ThreadPool::Global(), with 0 letting the pool balance the work freely.
+        void Build(std::span<const Vector3> points, unsigned threadCount = 1);
+        void Clear();
+
+        std::size_t Size() const
+        {
+            return points.size();
+        }
+        bool Empty() const
+        {
+            return points.empty();
+        }
+
+        // Returns InvalidIndex when the tree is empty.
+        std::uint32_t Nearest(const Vector3& point) const;
+        // Fills out with the out.size() nearest points sorted by distance and returns how many were found.
+        std::size_t KNearest(const Vector3& point, std::span<Neighbor> out) const;
+        // Append matching indices to out in no particular order.
+        void Radius(const Vector3& center, float radius, std::vector<std::uint32_t>& out) const;
+        void Box(const Vector3& min, const Vector3& max, std::vector<std::uint32_t>& out) const;
+
+        void Nearest(std::span<const Vector3> queries, std::span<std::uint32_t> out, unsigned threadCount = 1) const;
+        // Row i of out holds the k nearest neighbors of queries[i]; rows with fewer than k points are padded with
+        // InvalidIndex at infinite distance.
+        void KNearest(std::span<const Vector3> queries, std::size_t k, std::span<Neighbor> out, unsigned threadCount = 1) const;
+
+    private:
+        static constexpr std::uint32_t LeafAxis = 3;
+
+        struct Node
+        {
+            float split;
+            std::uint32_t axis;
+            // Leaves cover points [first, second); interior nodes keep their right child index in second.
+            std::uint32_t first;
+            std::uint32_t second;
+        };
+
+        struct BuildEntry;
+
+        std::vector<Node> nodes;
+        std::vector<Vector3> points;
+        std::vector<std::uint32_t> indices;
+
+        void BuildNode(std::uint32_t node, BuildEntry* entries, std::uint32_t begin, std::uint32_t end);
+        std::uint32_t SplitNode(std::uint32_t node, BuildEntry* entries, std::uint32_t begin, std::uint32_t end);
+    };
+}
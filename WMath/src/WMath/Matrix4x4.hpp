@@ -0,0 +1,420 @@
+﻿#pragma once
+
+#include <cassert>
+#include <span>
+#include <string>
+#include <type_traits>
+#include "WMath/Simd.hpp"
+#include "WMath/Utils.hpp"
+#include "WMath/Vector3.hpp"
+#include "WMath/Vector3Array.hpp"
+#include "WMath/Vector4.hpp"
+
+namespace WMath
+{
+    // Column-major, column vectors (M * v). Projection and view helpers are left-handed
+    // (Forward is +Z) and map depth to [0, 1].
+    class alignas(16) Matrix4x4
+    {
+    public:
+        static constexpr Matrix4x4 Zero()
+        {
+            return {Vector4::Zero(), Vector4::Zero(), Vector4::Zero(), Vector4::Zero()};
+        }
+        static constexpr Matrix4x4 Identity()
+        {
+            return {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+        }
+
+        Vector4 columns[4];
+
+        constexpr Matrix4x4() : columns{Vector4::Zero(), Vector4::Zero(), Vector4::Zero(), Vector4::Zero()} {}
+        constexpr Matrix4x4(const Vector4& column0, const Vector4& column1, const Vector4& column2, const Vector4& column3)
+            : columns{column0, column1, column2, column3} {}
+
+        constexpr float operator()(int row, int column) const
+        {
+            return columns[column][row];
+        }
+
+        constexpr float Get(int row, int column) const
+        {
+            return columns[column][row];
+        }
+        constexpr void Set(int row, int column, float value)
+        {
+            Vector4& target = columns[column];
+            if(row == 0) target.x = value;
+            else if(row == 1) target.y = value;
+            else if(row == 2) target.z = value;
+            else if(row == 3) target.w = value;
+        }
+
+        Vector4 GetRow(int row) const
+        {
+            return {columns[0][row], columns[1][row], columns[2][row], columns[3][row]};
+        }
+
+        bool operator==(const Matrix4x4& other) const
+        {
+            return Equals(other);
+        }
+        bool operator!=(const Matrix4x4& other) const
+        {
+            return !Equals(other);
+        }
+
+        Matrix4x4 operator*(const Matrix4x4& other) const
+        {
+            return {*this * other.columns[0], *this * other.columns[1], *this * other.columns[2], *this * other.columns[3]};
+        }
+        Matrix4x4& operator*=(const Matrix4x4& other)
+        {
+            return *this = *this * other;
+        }
+
+        Vector4 operator*(const Vector4& vector) const
+        {
+#if defined(WMATH_SSE2)
+            const __m128 value = vector.Load();
+            __m128 result = _mm_mul_ps(columns[0].Load(), _mm_shuffle_ps(value, value, _MM_SHUFFLE(0, 0, 0, 0)));
+            result = _mm_add_ps(result, _mm_mul_ps(columns[1].Load(), _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 1, 1, 1))));
+            result = _mm_add_ps(result, _mm_mul_ps(columns[2].Load(), _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 2, 2, 2))));
+            result = _mm_add_ps(result, _mm_mul_ps(columns[3].Load(), _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3))));
+            return result;
+#else
+            return columns[0] * vector.x + columns[1] * vector.y + columns[2] * vector.z + columns[3] * vector.w;
+#endif
+        }
+
+        bool Equals(const Matrix4x4& other, float epsilon = Epsilon) const
+        {
+            return columns[0].Equals(other.columns[0], epsilon) && columns[1].Equals(other.columns[1], epsilon) &&
+                columns[2].Equals(other.columns[2], epsilon) && columns[3].Equals(other.columns[3], epsilon);
+        }
+
+        bool IsAffine() const
+        {
+            return columns[0].w == 0 && columns[1].w == 0 && columns[2].w == 0 && columns[3].w == 1;
+        }
+
+        Vector3 GetTranslation() const
+        {
+            return columns[3].ToVector3();
+        }
+
+        Vector3 MultiplyPoint(const Vector3& point) const
+        {
+            return (*this * Vector4(point, 1)).Homogenized();
+        }
+        Vector3 MultiplyPoint3x4(const Vector3& point) const
+        {
+            return (*this * Vector4(point, 1)).ToVector3();
+        }
+        Vector3 MultiplyVector(const Vector3& vector) const
+        {
+            return (*this * Vector4(vector, 0)).ToVector3();
+        }
+
+        Matrix4x4 Transposed() const
+        {
+#if defined(WMATH_SSE2)
+            __m128 column0 = columns[0].Load();
+            __m128 column1 = columns[1].Load();
+            __m128 column2 = columns[2].Load();
+            __m128 column3 = columns[3].Load();
+            _MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+            return {column0, column1, column2, column3};
+#else
+            return {GetRow(0), GetRow(1), GetRow(2), GetRow(3)};
+#endif
+        }
+        void Transpose()
+        {
+            *this = Transposed();
+        }
+
+        float Determinant() const
+        {
+            const Matrix4x4& m = *this;
+            const float s0 = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1);
+            const float s1 = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+            const float s2 = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3);
+            const float s3 = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+            const float s4 = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3);
+            const float s5 = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
+            const float c5 = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+            const float c4 = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3);
+            const float c3 = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+            const float c2 = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3);
+            const float c1 = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+            const float c0 = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1);
+            return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        }
+
+        Matrix4x4 Inverse() const
+        {
+            const Matrix4x4& m = *this;
+            const float s0 = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1);
+            const float s1 = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+            const float s2 = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3);
+            const float s3 = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+            const float s4 = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3);
+            const float s5 = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
+            const float c5 = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+            const float c4 = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3);
+            const float c3 = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+            const float c2 = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3);
+            const float c1 = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+            const float c0 = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1);
+
+            const float inverseDeterminant = 1.0f / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+
+            Matrix4x4 result;
+            result.Set(0, 0, ( m(1, 1) * c5 - m(1, 2) * c4 + m(1, 3) * c3) * inverseDeterminant);
+            result.Set(0, 1, (-m(0, 1) * c5 + m(0, 2) * c4 - m(0, 3) * c3) * inverseDeterminant);
+            result.Set(0, 2, ( m(3, 1) * s5 - m(3, 2) * s4 + m(3, 3) * s3) * inverseDeterminant);
+            result.Set(0, 3, (-m(2, 1) * s5 + m(2, 2) * s4 - m(2, 3) * s3) * inverseDeterminant);
+
+            result.Set(1, 0, (-m(1, 0) * c5 + m(1, 2) * c2 - m(1, 3) * c1) * inverseDeterminant);
+            result.Set(1, 1, ( m(0, 0) * c5 - m(0, 2) * c2 + m(0, 3) * c1) * inverseDeterminant);
+            result.Set(1, 2, (-m(3, 0) * s5 + m(3, 2) * s2 - m(3, 3) * s1) * inverseDeterminant);
+            result.Set(1, 3, ( m(2, 0) * s5 - m(2, 2) * s2 + m(2, 3) * s1) * inverseDeterminant);
+
+            result.Set(2, 0, ( m(1, 0) * c4 - m(1, 1) * c2 + m(1, 3) * c0) * inverseDeterminant);
+            result.Set(2, 1, (-m(0, 0) * c4 + m(0, 1) * c2 - m(0, 3) * c0) * inverseDeterminant);
+            result.Set(2, 2, ( m(3, 0) * s4 - m(3, 1) * s2 + m(3, 3) * s0) * inverseDeterminant);
+            result.Set(2, 3, (-m(2, 0) * s4 + m(2, 1) * s2 - m(2, 3) * s0) * inverseDeterminant);
+
+            result.Set(3, 0, (-m(1, 0) * c3 + m(1, 1) * c1 - m(1, 2) * c0) * inverseDeterminant);
+            result.Set(3, 1, ( m(0, 0) * c3 - m(0, 1) * c1 + m(0, 2) * c0) * inverseDeterminant);
+            result.Set(3, 2, (-m(3, 0) * s3 + m(3, 1) * s1 - m(3, 2) * s0) * inverseDeterminant);
+            result.Set(3, 3, ( m(2, 0) * s3 - m(2, 1) * s1 + m(2, 2) * s0) * inverseDeterminant);
+            return result;
+        }
+
+        // Only valid when IsAffine() holds; skips the full 4x4 cofactor expansion.
+        Matrix4x4 InverseAffine() const
+        {
+            const Vector3 a = columns[0].ToVector3();
+            const Vector3 b = columns[1].ToVector3();
+            const Vector3 c = columns[2].ToVector3();
+
+            const Vector3 bc = Vector3::Cross(b, c);
+            const Vector3 ca = Vector3::Cross(c, a);
+            const Vector3 ab = Vector3::Cross(a, b);
+            const float inverseDeterminant = 1.0f / Vector3::Dot(a, bc);
+
+            const Vector4 row0(bc * inverseDeterminant, 0);
+            const Vector4 row1(ca * inverseDeterminant, 0);
+            const Vector4 row2(ab * inverseDeterminant, 0);
+            const Vector3 translation = GetTranslation();
+            const Vector4 inverseTranslation(-Vector3::Dot(row0.ToVector3(), translation), -Vector3::Dot(row1.ToVector3(), translation),
+                -Vector3::Dot(row2.ToVector3(), translation), 1);
+
+            Matrix4x4 result = Matrix4x4(row0, row1, row2, Vector4(0, 0, 0, 0)).Transposed();
+            result.columns[3] = inverseTranslation;
+            return result;
+        }
+
+        std::string ToString() const
+        {
+            return GetRow(0).ToString() + "\n" + GetRow(1).ToString() + "\n" + GetRow(2).ToString() + "\n" + GetRow(3).ToString();
+        }
+
+        void TransformPoints(std::span<const Vector3> points, std::span<Vector3> out) const
+        {
+            TransformVectors(points, out, 1.0f);
+        }
+        void TransformDirections(std::span<const Vector3> directions, std::span<Vector3> out) const
+        {
+            TransformVectors(directions, out, 0.0f);
+        }
+
+        void TransformPoints(const Vector3Array& points, Vector3Array& out) const
+        {
+            TransformVectors(points, out, 1.0f);
+        }
+        void TransformDirections(const Vector3Array& directions, Vector3Array& out) const
+        {
+            TransformVectors(directions, out, 0.0f);
+        }
+
+        static Matrix4x4 Translate(const Vector3& translation)
+        {
+            return {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, Vector4(translation, 1)};
+        }
+        static Matrix4x4 Scale(const Vector3& scale)
+        {
+            return {{scale.x, 0, 0, 0}, {0, scale.y, 0, 0}, {0, 0, scale.z, 0}, {0, 0, 0, 1}};
+        }
+        static Matrix4x4 RotateX(float degrees)
+        {
+            const float radians = degrees * Deg2Rad;
+            const float cos = Cos(radians);
+            const float sin = Sin(radians);
+            return {{1, 0, 0, 0}, {0, cos, sin, 0}, {0, -sin, cos, 0}, {0, 0, 0, 1}};
+        }
+        static Matrix4x4 RotateY(float degrees)
+        {
+            const float radians = degrees * Deg2Rad;
+            const float cos = Cos(radians);
+            const float sin = Sin(radians);
+            return {{cos, 0, -sin, 0}, {0, 1, 0, 0}, {sin, 0, cos, 0}, {0, 0, 0, 1}};
+        }
+        static Matrix4x4 RotateZ(float degrees)
+        {
+            const float radians = degrees * Deg2Rad;
+            const float cos = Cos(radians);
+            const float sin = Sin(radians);
+            return {{cos, sin, 0, 0}, {-sin, cos, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+        }
+        // Euler angles in degrees, applied around Z, then X, then Y.
+        static Matrix4x4 Rotate(const Vector3& eulerAngles)
+        {
+            return RotateY(eulerAngles.y) * RotateX(eulerAngles.x) * RotateZ(eulerAngles.z);
+        }
+        static Matrix4x4 TRS(const Vector3& translation, const Vector3& eulerAngles, const Vector3& scale)
+        {
+            Matrix4x4 result = Rotate(eulerAngles);
+            result.columns[0] *= scale.x;
+            result.columns[1] *= scale.y;
+            result.columns[2] *= scale.z;
+            result.columns[3] = Vector4(translation, 1);
+            return result;
+        }
+
+        static Matrix4x4 LookAt(const Vector3& eye, const Vector3& target, const Vector3& up)
+        {
+            const Vector3 forward = (target - eye).Normalized();
+            const Vector3 right = Vector3::Cross(up, forward).Normalized();
+            const Vector3 cameraUp = Vector3::Cross(forward, right);
+
+            return {{right.x, cameraUp.x, forward.x, 0},
+                {right.y, cameraUp.y, forward.y, 0},
+                {right.z, cameraUp.z, forward.z, 0},
+                {-Vector3::Dot(right, eye), -Vector3::Dot(cameraUp, eye), -Vector3::Dot(forward, eye), 1}};
+        }
+        static Matrix4x4 Perspective(float fieldOfView, float aspect, float nearPlane, float farPlane)
+        {
+            const float yScale = 1.0f / Tan(fieldOfView * Deg2Rad * 0.5f);
+            const float xScale = yScale / aspect;
+            const float depthScale = farPlane / (farPlane - nearPlane);
+
+            return {{xScale, 0, 0, 0}, {0, yScale, 0, 0}, {0, 0, depthScale, 1}, {0, 0, -nearPlane * depthScale, 0}};
+        }
+        static Matrix4x4 Orthographic(float left, float right, float bottom, float top, float nearPlane, float farPlane)
+        {
+            const float width = right - left;
+            const float height = top - bottom;
+            const float depth = farPlane - nearPlane;
+
+            return {{2.0f / width, 0, 0, 0}, {0, 2.0f / height, 0, 0}, {0, 0, 1.0f / depth, 0},
+                {-(right + left) / width, -(top + bottom) / height, -nearPlane / depth, 1}};
+        }
+
+    private:
+        void TransformVectors(std::span<const Vector3> in, std::span<Vector3> out, float w) const
+        {
+            static_assert(sizeof(Vector3) == 3 * sizeof(float));
+            assert(out.size() >= in.size());
+
+            const std::size_t count = in.size();
+            std::size_t i = 0;
+#if defined(WMATH_SSE2)
+            const float* source = reinterpret_cast<const float*>(in.data());
+            float* destination = reinterpret_cast<float*>(out.data());
+
+            const __m128 m00 = _mm_set1_ps(columns[0].x), m10 = _mm_set1_ps(columns[0].y), m20 = _mm_set1_ps(columns[0].z);
+            const __m128 m01 = _mm_set1_ps(columns[1].x), m11 = _mm_set1_ps(columns[1].y), m21 = _mm_set1_ps(columns[1].z);
+            const __m128 m02 = _mm_set1_ps(columns[2].x), m12 = _mm_set1_ps(columns[2].y), m22 = _mm_set1_ps(columns[2].z);
+            const __m128 m03 = _mm_set1_ps(columns[3].x * w), m13 = _mm_set1_ps(columns[3].y * w), m23 = _mm_set1_ps(columns[3].z * w);
+
+            for(; i + 4 <= count; i += 4)
+            {
+                const __m128 x0y0z0x1 = _mm_loadu_ps(source + i * 3);
+                const __m128 y1z1x2y2 = _mm_loadu_ps(source + i * 3 + 4);
+                const __m128 z2x3y3z3 = _mm_loadu_ps(source + i * 3 + 8);
+
+                const __m128 x2y2x3y3 = _mm_shuffle_ps(y1z1x2y2, z2x3y3z3, _MM_SHUFFLE(2, 1, 3, 2));
+                const __m128 y0z0y1z1 = _mm_shuffle_ps(x0y0z0x1, y1z1x2y2, _MM_SHUFFLE(1, 0, 2, 1));
+                const __m128 x = _mm_shuffle_ps(x0y0z0x1, x2y2x3y3, _MM_SHUFFLE(2, 0, 3, 0));
+                const __m128 y = _mm_shuffle_ps(y0z0y1z1, x2y2x3y3, _MM_SHUFFLE(3, 1, 2, 0));
+                const __m128 z = _mm_shuffle_ps(y0z0y1z1, z2x3y3z3, _MM_SHUFFLE(3, 0, 3, 1));
+
+                const __m128 resultX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), _mm_add_ps(_mm_mul_ps(m02, z), m03));
+                const __m128 resultY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), _mm_add_ps(_mm_mul_ps(m12, z), m13));
+                const __m128 resultZ = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)), _mm_add_ps(_mm_mul_ps(m22, z), m23));
+
+                const __m128 xy01 = _mm_unpacklo_ps(resultX, resultY);
+                const __m128 xy23 = _mm_unpackhi_ps(resultX, resultY);
+                const __m128 zx01 = _mm_shuffle_ps(resultZ, resultX, _MM_SHUFFLE(1, 1, 0, 0));
+                const __m128 yz11 = _mm_shuffle_ps(resultY, resultZ, _MM_SHUFFLE(1, 1, 1, 1));
+                const __m128 zx23 = _mm_shuffle_ps(resultZ, resultX, _MM_SHUFFLE(3, 3, 2, 2));
+                const __m128 yz33 = _mm_shuffle_ps(resultY, resultZ, _MM_SHUFFLE(3, 3, 3, 3));
+
+                _mm_storeu_ps(destination + i * 3, _mm_shuffle_ps(xy01, zx01, _MM_SHUFFLE(2, 0, 1, 0)));
+                _mm_storeu_ps(destination + i * 3 + 4, _mm_shuffle_ps(yz11, xy23, _MM_SHUFFLE(1, 0, 2, 0)));
+                _mm_storeu_ps(destination + i * 3 + 8, _mm_shuffle_ps(zx23, yz33, _MM_SHUFFLE(2, 0, 2, 0)));
+            }
+#endif
+            for(; i < count; i++)
+            {
+                const Vector3 vector = in[i];
+                out[i] = {
+                    columns[0].x * vector.x + columns[1].x * vector.y + columns[2].x * vector.z + columns[3].x * w,
+                    columns[0].y * vector.x + columns[1].y * vector.y + columns[2].y * vector.z + columns[3].y * w,
+                    columns[0].z * vector.x + columns[1].z * vector.y + columns[2].z * vector.z + columns[3].z * w};
+            }
+        }
+
+        void TransformVectors(const Vector3Array& in, Vector3Array& out, float w) const
+        {
+            const std::size_t count = in.Size();
+            out.Resize(count);
+
+            const float* inX = in.x.data(); const float* inY = in.y.data(); const float* inZ = in.z.data();
+            float* outX = out.x.data(); float* outY = out.y.data(); float* outZ = out.z.data();
+
+            std::size_t i = 0;
+#if defined(WMATH_AVX)
+            const __m256 m00 = _mm256_set1_ps(columns[0].x), m10 = _mm256_set1_ps(columns[0].y), m20 = _mm256_set1_ps(columns[0].z);
+            const __m256 m01 = _mm256_set1_ps(columns[1].x), m11 = _mm256_set1_ps(columns[1].y), m21 = _mm256_set1_ps(columns[1].z);
+            const __m256 m02 = _mm256_set1_ps(columns[2].x), m12 = _mm256_set1_ps(columns[2].y), m22 = _mm256_set1_ps(columns[2].z);
+            const __m256 m03 = _mm256_set1_ps(columns[3].x * w), m13 = _mm256_set1_ps(columns[3].y * w), m23 = _mm256_set1_ps(columns[3].z * w);
+
+            for(; i + 8 <= count; i += 8)
+            {
+                const __m256 x = _mm256_loadu_ps(inX + i);
+                const __m256 y = _mm256_loadu_ps(inY + i);
+                const __m256 z = _mm256_loadu_ps(inZ + i);
+
+                const __m256 resultX = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, x), _mm256_mul_ps(m01, y)), _mm256_add_ps(_mm256_mul_ps(m02, z), m03));
+                const __m256 resultY = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m10, x), _mm256_mul_ps(m11, y)), _mm256_add_ps(_mm256_mul_ps(m12, z), m13));
+                const __m256 resultZ = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m20, x), _mm256_mul_ps(m21, y)), _mm256_add_ps(_mm256_mul_ps(m22, z), m23));
+
+                _mm256_storeu_ps(outX + i, resultX);
+                _mm256_storeu_ps(outY + i, resultY);
+                _mm256_storeu_ps(outZ + i, resultZ);
+            }
+#endif
+            for(; i < count; i++)
+            {
+                const float x = inX[i];
+                const float y = inY[i];
+                const float z = inZ[i];
+                outX[i] = columns[0].x * x + columns[1].x * y + columns[2].x * z + columns[3].x * w;
+                outY[i] = columns[0].y * x + columns[1].y * y + columns[2].y * z + columns[3].y * w;
+                outZ[i] = columns[0].z * x + columns[1].z * y + columns[2].z * z + columns[3].z * w;
+            }
+        }
+    };
+
+    static_assert(std::is_trivially_copyable_v<Matrix4x4> && std::is_standard_layout_v<Matrix4x4>);
+    static_assert(sizeof(Matrix4x4) == 16 * sizeof(float));
+
+    inline bool Equals(const Matrix4x4& lhs, const Matrix4x4& rhs, float epsilon = Epsilon)
+    {
+        return lhs.Equals(rhs, epsilon);
+    }
+}
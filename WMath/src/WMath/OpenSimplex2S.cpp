@@ -0,0 +1,353 @@
+﻿#include "OpenSimplex2S.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+#include "WMath/Simd.hpp"
+
+namespace
+{
+    constexpr std::int32_t PrimeX = 501125321;
+    constexpr std::int32_t PrimeY = 1136930381;
+    constexpr std::int32_t PrimeZ = 1720413743;
+    constexpr std::int32_t HashMultiplier = 0x27D4EB2D;
+    constexpr std::int32_t SecondLatticeSeedOffset = 1293373;
+
+    constexpr float Skew2D = 0.36602540378443864676f;
+    constexpr float Unskew2D = 0.21132486540518711775f;
+    constexpr float Scale2D = 18.24196194486065f;
+    constexpr float Scale3D = 9.046026385208288f;
+
+    constexpr std::size_t BlockSize = 64;
+
+    constexpr std::int32_t WrappingMultiply(std::int32_t a, std::int32_t b)
+    {
+        return static_cast<std::int32_t>(static_cast<std::uint32_t>(a) * static_cast<std::uint32_t>(b));
+    }
+
+    alignas(64) constexpr float Gradients2D[256] =
+    {
+            0.130526192f, 0.991444861f, 0.382683432f, 0.923879533f, 0.608761429f, 0.793353340f, 0.793353340f, 0.608761429f,
+            0.923879533f, 0.382683432f, 0.991444861f, 0.130526192f, 0.991444861f, -0.130526192f, 0.923879533f, -0.382683432f,
+            0.793353340f, -0.608761429f, 0.608761429f, -0.793353340f, 0.382683432f, -0.923879533f, 0.130526192f, -0.991444861f,
+            -0.130526192f, -0.991444861f, -0.382683432f, -0.923879533f, -0.608761429f, -0.793353340f, -0.793353340f, -0.608761429f,
+            -0.923879533f, -0.382683432f, -0.991444861f, -0.130526192f, -0.991444861f, 0.130526192f, -0.923879533f, 0.382683432f,
+            -0.793353340f, 0.608761429f, -0.608761429f, 0.793353340f, -0.382683432f, 0.923879533f, -0.130526192f, 0.991444861f,
+            0.130526192f, 0.991444861f, 0.382683432f, 0.923879533f, 0.608761429f, 0.793353340f, 0.793353340f, 0.608761429f,
+            0.923879533f, 0.382683432f, 0.991444861f, 0.130526192f, 0.991444861f, -0.130526192f, 0.923879533f, -0.382683432f,
+            0.793353340f, -0.608761429f, 0.608761429f, -0.793353340f, 0.382683432f, -0.923879533f, 0.130526192f, -0.991444861f,
+            -0.130526192f, -0.991444861f, -0.382683432f, -0.923879533f, -0.608761429f, -0.793353340f, -0.793353340f, -0.608761429f,
+            -0.923879533f, -0.382683432f, -0.991444861f, -0.130526192f, -0.991444861f, 0.130526192f, -0.923879533f, 0.382683432f,
+            -0.793353340f, 0.608761429f, -0.608761429f, 0.793353340f, -0.382683432f, 0.923879533f, -0.130526192f, 0.991444861f,
+            0.130526192f, 0.991444861f, 0.382683432f, 0.923879533f, 0.608761429f, 0.793353340f, 0.793353340f, 0.608761429f,
+            0.923879533f, 0.382683432f, 0.991444861f, 0.130526192f, 0.991444861f, -0.130526192f, 0.923879533f, -0.382683432f,
+            0.793353340f, -0.608761429f, 0.608761429f, -0.793353340f, 0.382683432f, -0.923879533f, 0.130526192f, -0.991444861f,
+            -0.130526192f, -0.991444861f, -0.382683432f, -0.923879533f, -0.608761429f, -0.793353340f, -0.793353340f, -0.608761429f,
+            -0.923879533f, -0.382683432f, -0.991444861f, -0.130526192f, -0.991444861f, 0.130526192f, -0.923879533f, 0.382683432f,
+            -0.793353340f, 0.608761429f, -0.608761429f, 0.793353340f, -0.382683432f, 0.923879533f, -0.130526192f, 0.991444861f,
+            0.130526192f, 0.991444861f, 0.382683432f, 0.923879533f, 0.608761429f, 0.793353340f, 0.793353340f, 0.608761429f,
+            0.923879533f, 0.382683432f, 0.991444861f, 0.130526192f, 0.991444861f, -0.130526192f, 0.923879533f, -0.382683432f,
+            0.793353340f, -0.608761429f, 0.608761429f, -0.793353340f, 0.382683432f, -0.923879533f, 0.130526192f, -0.991444861f,
+            -0.130526192f, -0.991444861f, -0.382683432f, -0.923879533f, -0.608761429f, -0.793353340f, -0.793353340f, -0.608761429f,
+            -0.923879533f, -0.382683432f, -0.991444861f, -0.130526192f, -0.991444861f, 0.130526192f, -0.923879533f, 0.382683432f,
+            -0.793353340f, 0.608761429f, -0.608761429f, 0.793353340f, -0.382683432f, 0.923879533f, -0.130526192f, 0.991444861f,
+            0.130526192f, 0.991444861f, 0.382683432f, 0.923879533f, 0.608761429f, 0.793353340f, 0.793353340f, 0.608761429f,
+            0.923879533f, 0.382683432f, 0.991444861f, 0.130526192f, 0.991444861f, -0.130526192f, 0.923879533f, -0.382683432f,
+            0.793353340f, -0.608761429f, 0.608761429f, -0.793353340f, 0.382683432f, -0.923879533f, 0.130526192f, -0.991444861f,
+            -0.130526192f, -0.991444861f, -0.382683432f, -0.923879533f, -0.608761429f, -0.793353340f, -0.793353340f, -0.608761429f,
+            -0.923879533f, -0.382683432f, -0.991444861f, -0.130526192f, -0.991444861f, 0.130526192f, -0.923879533f, 0.382683432f,
+            -0.793353340f, 0.608761429f, -0.608761429f, 0.793353340f, -0.382683432f, 0.923879533f, -0.130526192f, 0.991444861f,
+            0.382683432f, 0.923879533f, 0.923879533f, 0.382683432f, 0.923879533f, -0.382683432f, 0.382683432f, -0.923879533f,
+            -0.382683432f, -0.923879533f, -0.923879533f, -0.382683432f, -0.923879533f, 0.382683432f, -0.382683432f, 0.923879533f
+    };
+
+    alignas(64) constexpr float Gradients3D[256] =
+    {
+        0, 1, 1, 0,  0, -1, 1, 0,  0, 1, -1, 0,  0, -1, -1, 0,
+        1, 0, 1, 0,  -1, 0, 1, 0,  1, 0, -1, 0,  -1, 0, -1, 0,
+        1, 1, 0, 0,  -1, 1, 0, 0,  1, -1, 0, 0,  -1, -1, 0, 0,
+        0, 1, 1, 0,  0, -1, 1, 0,  0, 1, -1, 0,  0, -1, -1, 0,
+        1, 0, 1, 0,  -1, 0, 1, 0,  1, 0, -1, 0,  -1, 0, -1, 0,
+        1, 1, 0, 0,  -1, 1, 0, 0,  1, -1, 0, 0,  -1, -1, 0, 0,
+        0, 1, 1, 0,  0, -1, 1, 0,  0, 1, -1, 0,  0, -1, -1, 0,
+        1, 0, 1, 0,  -1, 0, 1, 0,  1, 0, -1, 0,  -1, 0, -1, 0,
+        1, 1, 0, 0,  -1, 1, 0, 0,  1, -1, 0, 0,  -1, -1, 0, 0,
+        0, 1, 1, 0,  0, -1, 1, 0,  0, 1, -1, 0,  0, -1, -1, 0,
+        1, 0, 1, 0,  -1, 0, 1, 0,  1, 0, -1, 0,  -1, 0, -1, 0,
+        1, 1, 0, 0,  -1, 1, 0, 0,  1, -1, 0, 0,  -1, -1, 0, 0,
+        0, 1, 1, 0,  0, -1, 1, 0,  0, 1, -1, 0,  0, -1, -1, 0,
+        1, 0, 1, 0,  -1, 0, 1, 0,  1, 0, -1, 0,  -1, 0, -1, 0,
+        1, 1, 0, 0,  -1, 1, 0, 0,  1, -1, 0, 0,  -1, -1, 0, 0,
+        1, 1, 0, 0,  0, -1, 1, 0,  -1, 1, 0, 0,  0, -1, -1, 0
+    };
+
+    template<typename L>
+    typename L::Int Hash(typename L::Int seed, typename L::Int xPrimed, typename L::Int yPrimed)
+    {
+        typename L::Int hash = L::IntXor(seed, L::IntXor(xPrimed, yPrimed));
+        hash = L::IntMul(hash, L::SetInt(HashMultiplier));
+        return L::IntXor(hash, L::template IntShiftRight<15>(hash));
+    }
+
+    template<typename L>
+    typename L::Int Hash(typename L::Int seed, typename L::Int xPrimed, typename L::Int yPrimed, typename L::Int zPrimed)
+    {
+        typename L::Int hash = L::IntXor(seed, L::IntXor(xPrimed, L::IntXor(yPrimed, zPrimed)));
+        hash = L::IntMul(hash, L::SetInt(HashMultiplier));
+        return L::IntXor(hash, L::template IntShiftRight<15>(hash));
+    }
+
+    // Every lattice vertex whose radius can reach a point is visited; vertices out of range fall off to zero,
+    // which replaces the branchy vertex selection of the scalar reference with straight-line lane code.
+    template<typename L>
+    typename L::Float Contribution2D(typename L::Int seed, typename L::Int xPrimed, typename L::Int yPrimed,
+        typename L::Float dx, typename L::Float dy)
+    {
+        typename L::Float falloff = L::Sub(L::Sub(L::Set(2.0f / 3.0f), L::Mul(dx, dx)), L::Mul(dy, dy));
+        falloff = L::Max(falloff, L::Set(0.0f));
+        falloff = L::Mul(falloff, falloff);
+
+        const typename L::Int index = L::IntAnd(Hash<L>(seed, xPrimed, yPrimed), L::SetInt(127 << 1));
+        const typename L::Float gradient = L::Add(L::Mul(dx, L::Gather(Gradients2D, index)),
+            L::Mul(dy, L::Gather(Gradients2D, L::IntOr(index, L::SetInt(1)))));
+
+        return L::Mul(L::Mul(falloff, falloff), gradient);
+    }
+
+    template<typename L>
+    typename L::Float Contribution3D(typename L::Int seed, typename L::Int xPrimed, typename L::Int yPrimed, typename L::Int zPrimed,
+        typename L::Float dx, typename L::Float dy, typename L::Float dz)
+    {
+        typename L::Float falloff = L::Sub(L::Sub(L::Sub(L::Set(0.75f), L::Mul(dx, dx)), L::Mul(dy, dy)), L::Mul(dz, dz));
+        falloff = L::Max(falloff, L::Set(0.0f));
+        falloff = L::Mul(falloff, falloff);
+
+        const typename L::Int index = L::IntAnd(Hash<L>(seed, xPrimed, yPrimed, zPrimed), L::SetInt(63 << 2));
+        const typename L::Float gradient = L::Add(L::Add(L::Mul(dx, L::Gather(Gradients3D, index)),
+            L::Mul(dy, L::Gather(Gradients3D, L::IntOr(index, L::SetInt(1))))),
+            L::Mul(dz, L::Gather(Gradients3D, L::IntOr(index, L::SetInt(2)))));
+
+        return L::Mul(L::Mul(falloff, falloff), gradient);
+    }
+
+    template<typename L>
+    typename L::Float Evaluate2D(std::int32_t seed, float frequency, typename L::Float x, typename L::Float y)
+    {
+        x = L::Mul(x, L::Set(frequency));
+        y = L::Mul(y, L::Set(frequency));
+        const typename L::Float skew = L::Mul(L::Add(x, y), L::Set(Skew2D));
+        x = L::Add(x, skew);
+        y = L::Add(y, skew);
+
+        const typename L::Float xFloor = L::Floor(x);
+        const typename L::Float yFloor = L::Floor(y);
+        const typename L::Int i = L::IntMul(L::ToInt(xFloor), L::SetInt(PrimeX));
+        const typename L::Int j = L::IntMul(L::ToInt(yFloor), L::SetInt(PrimeY));
+
+        const typename L::Float xi = L::Sub(x, xFloor);
+        const typename L::Float yi = L::Sub(y, yFloor);
+        const typename L::Float unskew = L::Mul(L::Add(xi, yi), L::Set(Unskew2D));
+        const typename L::Float x0 = L::Sub(xi, unskew);
+        const typename L::Float y0 = L::Sub(yi, unskew);
+
+        const typename L::Int seedLanes = L::SetInt(seed);
+        typename L::Float value = Contribution2D<L>(seedLanes, i, j, x0, y0);
+
+        constexpr int offsets[7][2] = {{1, 1}, {1, 0}, {0, 1}, {2, 1}, {1, 2}, {-1, 0}, {0, -1}};
+        for(const auto& offset : offsets)
+        {
+            const float unskewedOffset = static_cast<float>(offset[0] + offset[1]) * Unskew2D;
+            const typename L::Float dx = L::Sub(x0, L::Set(static_cast<float>(offset[0]) - unskewedOffset));
+            const typename L::Float dy = L::Sub(y0, L::Set(static_cast<float>(offset[1]) - unskewedOffset));
+            value = L::Add(value, Contribution2D<L>(seedLanes,
+                L::IntAdd(i, L::SetInt(WrappingMultiply(offset[0], PrimeX))), L::IntAdd(j, L::SetInt(WrappingMultiply(offset[1], PrimeY))), dx, dy));
+        }
+
+        return L::Mul(value, L::Set(Scale2D));
+    }
+
+    template<typename L>
+    typename L::Float EvaluateCube3D(typename L::Int seed, typename L::Float x, typename L::Float y, typename L::Float z)
+    {
+        const typename L::Float xFloor = L::Floor(x);
+        const typename L::Float yFloor = L::Floor(y);
+        const typename L::Float zFloor = L::Floor(z);
+        const typename L::Int i = L::IntMul(L::ToInt(xFloor), L::SetInt(PrimeX));
+        const typename L::Int j = L::IntMul(L::ToInt(yFloor), L::SetInt(PrimeY));
+        const typename L::Int k = L::IntMul(L::ToInt(zFloor), L::SetInt(PrimeZ));
+        const typename L::Float xi = L::Sub(x, xFloor);
+        const typename L::Float yi = L::Sub(y, yFloor);
+        const typename L::Float zi = L::Sub(z, zFloor);
+
+        typename L::Float value = L::Set(0.0f);
+        for(int corner = 0; corner < 8; corner++)
+        {
+            const int cx = corner & 1;
+            const int cy = (corner >> 1) & 1;
+            const int cz = corner >> 2;
+            value = L::Add(value, Contribution3D<L>(seed,
+                cx ? L::IntAdd(i, L::SetInt(PrimeX)) : i,
+                cy ? L::IntAdd(j, L::SetInt(PrimeY)) : j,
+                cz ? L::IntAdd(k, L::SetInt(PrimeZ)) : k,
+                L::Sub(xi, L::Set(static_cast<float>(cx))),
+                L::Sub(yi, L::Set(static_cast<float>(cy))),
+                L::Sub(zi, L::Set(static_cast<float>(cz)))));
+        }
+        return value;
+    }
+
+    // The 3D variant sums two interleaved cubic lattices (a body-centred cubic lattice); the second one is
+    // offset by half a cell and hashed with its own seed. Only the corners of each enclosing cube are in range.
+    template<typename L>
+    typename L::Float Evaluate3D(std::int32_t seed, float frequency, typename L::Float x, typename L::Float y, typename L::Float z)
+    {
+        x = L::Mul(x, L::Set(frequency));
+        y = L::Mul(y, L::Set(frequency));
+        z = L::Mul(z, L::Set(frequency));
+        const typename L::Float rotation = L::Mul(L::Add(L::Add(x, y), z), L::Set(2.0f / 3.0f));
+        x = L::Sub(rotation, x);
+        y = L::Sub(rotation, y);
+        z = L::Sub(rotation, z);
+
+        const typename L::Float half = L::Set(0.5f);
+        typename L::Float value = EvaluateCube3D<L>(L::SetInt(seed), x, y, z);
+        value = L::Add(value, EvaluateCube3D<L>(L::IntAdd(L::SetInt(seed), L::SetInt(SecondLatticeSeedOffset)), L::Add(x, half), L::Add(y, half), L::Add(z, half)));
+
+        return L::Mul(value, L::Set(Scale3D));
+    }
+
+    template<typename L>
+    void EvaluateBlock2D(std::int32_t seed, float frequency, const float* x, const float* y, float* out, std::size_t count)
+    {
+        std::size_t i = 0;
+        for(; i + L::Width <= count; i += L::Width)
+        {
+            L::Store(out + i, Evaluate2D<L>(seed, frequency, L::Load(x + i), L::Load(y + i)));
+        }
+        if(i == count) return;
+
+        float paddedX[L::Width] = {};
+        float paddedY[L::Width] = {};
+        float paddedOut[L::Width];
+        for(std::size_t lane = 0; i + lane < count; lane++)
+        {
+            paddedX[lane] = x[i + lane];
+            paddedY[lane] = y[i + lane];
+        }
+        L::Store(paddedOut, Evaluate2D<L>(seed, frequency, L::Load(paddedX), L::Load(paddedY)));
+        for(std::size_t lane = 0; i + lane < count; lane++) out[i + lane] = paddedOut[lane];
+    }
+
+    template<typename L>
+    void EvaluateBlock3D(std::int32_t seed, float frequency, const float* x, const float* y, const float* z, float* out, std::size_t count)
+    {
+        std::size_t i = 0;
+        for(; i + L::Width <= count; i += L::Width)
+        {
+            L::Store(out + i, Evaluate3D<L>(seed, frequency, L::Load(x + i), L::Load(y + i), L::Load(z + i)));
+        }
+        if(i == count) return;
+
+        float paddedX[L::Width] = {};
+        float paddedY[L::Width] = {};
+        float paddedZ[L::Width] = {};
+        float paddedOut[L::Width];
+        for(std::size_t lane = 0; i + lane < count; lane++)
+        {
+            paddedX[lane] = x[i + lane];
+            paddedY[lane] = y[i + lane];
+            paddedZ[lane] = z[i + lane];
+        }
+        L::Store(paddedOut, Evaluate3D<L>(seed, frequency, L::Load(paddedX), L::Load(paddedY), L::Load(paddedZ)));
+        for(std::size_t lane = 0; i + lane < count; lane++) out[i + lane] = paddedOut[lane];
+    }
+}
+
+float WMath::OpenSimplex2S::GetNoise(float x, float y) const
+{
+    return Evaluate2D<Simd::ScalarLanes>(seed, frequency, x, y);
+}
+
+float WMath::OpenSimplex2S::GetNoise(float x, float y, float z) const
+{
+    return Evaluate3D<Simd::ScalarLanes>(seed, frequency, x, y, z);
+}
+
+void WMath::OpenSimplex2S::GetNoise(std::span<const float> x, std::span<const float> y, std::span<float> out) const
+{
+    assert(y.size() == x.size() && out.size() >= x.size());
+    EvaluateBlock2D<Simd::NativeLanes>(seed, frequency, x.data(), y.data(), out.data(), x.size());
+}
+
+void WMath::OpenSimplex2S::GetNoise(std::span<const float> x, std::span<const float> y, std::span<const float> z, std::span<float> out) const
+{
+    assert(y.size() == x.size() && z.size() == x.size() && out.size() >= x.size());
+    EvaluateBlock3D<Simd::NativeLanes>(seed, frequency, x.data(), y.data(), z.data(), out.data(), x.size());
+}
+
+void WMath::OpenSimplex2S::GetNoise(std::span<const Vector2> points, std::span<float> out) const
+{
+    assert(out.size() >= points.size());
+    float x[BlockSize];
+    float y[BlockSize];
+    for(std::size_t offset = 0; offset < points.size(); offset += BlockSize)
+    {
+        const std::size_t count = points.size() - offset < BlockSize ? points.size() - offset : BlockSize;
+        for(std::size_t i = 0; i < count; i++)
+        {
+            x[i] = points[offset + i].x;
+            y[i] = points[offset + i].y;
+        }
+        EvaluateBlock2D<Simd::NativeLanes>(seed, frequency, x, y, out.data() + offset, count);
+    }
+}
+
+void WMath::OpenSimplex2S::GetNoise(std::span<const Vector3> points, std::span<float> out) const
+{
+    assert(out.size() >= points.size());
+    float x[BlockSize];
+    float y[BlockSize];
+    float z[BlockSize];
+    for(std::size_t offset = 0; offset < points.size(); offset += BlockSize)
+    {
+        const std::size_t count = points.size() - offset < BlockSize ? points.size() - offset : BlockSize;
+        for(std::size_t i = 0; i < count; i++)
+        {
+            x[i] = points[offset + i].x;
+            y[i] = points[offset + i].y;
+            z[i] = points[offset + i].z;
+        }
+        EvaluateBlock3D<Simd::NativeLanes>(seed, frequency, x, y, z, out.data() + offset, count);
+    }
+}
+
+void WMath::OpenSimplex2S::GetNoiseRow(const Vector2& start, float stepX, std::span<float> out) const
+{
+    float x[BlockSize];
+    float y[BlockSize];
+    for(std::size_t i = 0; i < BlockSize; i++) y[i] = start.y;
+    for(std::size_t offset = 0; offset < out.size(); offset += BlockSize)
+    {
+        const std::size_t count = out.size() - offset < BlockSize ? out.size() - offset : BlockSize;
+        for(std::size_t i = 0; i < count; i++) x[i] = start.x + stepX * static_cast<float>(offset + i);
+        EvaluateBlock2D<Simd::NativeLanes>(seed, frequency, x, y, out.data() + offset, count);
+    }
+}
+
+void WMath::OpenSimplex2S::GetNoiseRow(const Vector3& start, float stepX, std::span<float> out) const
+{
+    float x[BlockSize];
+    float y[BlockSize];
+    float z[BlockSize];
+    for(std::size_t i = 0; i < BlockSize; i++)
+    {
+        y[i] = start.y;
+        z[i] = start.z;
+    }
+    for(std::size_t offset = 0; offset < out.size(); offset += BlockSize)
+    {
+        const std::size_t count = out.size() - offset < BlockSize ? out.size() - offset : BlockSize;
+        for(std::size_t i = 0; i < count; i++) x[i] = start.x + stepX * static_cast<float>(offset + i);
+        EvaluateBlock3D<Simd::NativeLanes>(seed, frequency, x, y, z, out.data() + offset, count);
+    }
+}
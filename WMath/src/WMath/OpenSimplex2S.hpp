@@ -0,0 +1,58 @@
+﻿#pragma once
+
+#include <span>
+
+#include "WMath/Vector2.hpp"
+#include "WMath/Vector3.hpp"
+
+namespace WMath
+{
+    // OpenSimplex2S gradient noise following FastNoiseLite's OpenSimplex2S, with its gradient tables and default seed of
+    // 1337. Tests/OpenSimplex2SReference.cpp compares the two when the FastNoiseLite submodule is checked out.
+    // The scalar and SSE4.1/AVX2 paths share one lane-generic kernel: they are bit-identical unless the
+    // compiler contracts multiply-adds into FMAs, and stay within 1e-6 of each other even then.
+    class OpenSimplex2S
+    {
+    public:
+        OpenSimplex2S() : OpenSimplex2S(1337) {}
+        explicit OpenSimplex2S(int seed, float frequency = 0.01f) : seed(seed), frequency(frequency) {}
+
+        void SetSeed(int newSeed)
+        {
+            seed = newSeed;
+        }
+        int GetSeed() const
+        {
+            return seed;
+        }
+
+        void SetFrequency(float newFrequency)
+        {
+            frequency = newFrequency;
+        }
+        float GetFrequency() const
+        {
+            return frequency;
+        }
+
+        float GetNoise(float x, float y) const;
+
+        float GetNoise(float x, float y, float z) const;
+
+        void GetNoise(std::span<const float> x, std::span<const float> y, std::span<float> out) const;
+
+        void GetNoise(std::span<const float> x, std::span<const float> y, std::span<const float> z, std::span<float> out) const;
+
+        void GetNoise(std::span<const Vector2> points, std::span<float> out) const;
+
+        void GetNoise(std::span<const Vector3> points, std::span<float> out) const;
+
+        void GetNoiseRow(const Vector2& start, float stepX, std::span<float> out) const;
+
+        void GetNoiseRow(const Vector3& start, float stepX, std::span<float> out) const;
+
+    private:
+        int seed;
+        float frequency;
+    };
+}
@@ -0,0 +1,127 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include "WMath/ThreadPool.hpp"
+
+namespace WMath::Parallel
+{
+    // Elements per chunk unless a call passes its own grain size. Chunks much cheaper than a few microseconds cost more
+    // in scheduling than they gain.
+    constexpr std::size_t DefaultGrainSize = 16384;
+
+    // Calls function(begin, end) for chunks of [0, count) on ThreadPool::Global().
+    template<typename Function>
+    void For(std::size_t count, const Function& function, std::size_t grainSize = DefaultGrainSize)
+    {
+        ThreadPool::Global().For(count, grainSize, function);
+    }
+
+    // How many chunks a threadCount asks for: 0 means a few per pool thread, so uneven chunks still balance, and anything
+    // else is taken as is.
+    inline std::size_t ChunkCount(unsigned threadCount)
+    {
+        return threadCount == 0 ? 4 * static_cast<std::size_t>(ThreadPool::Global().Size()) : threadCount;
+    }
+
+    // The threadCount policy of every batch call that takes one. A threadCount of 1, or a range of at most grainSize
+    // elements, runs as a single function(0, count) on the calling thread; otherwise 0 lets the pool balance chunks of
+    // grainSize and anything else cuts [0, count) into threadCount chunks. grainSize is the smallest range worth
+    // handing to another thread, so it is the only thing callers tune to their per-element cost.
+    template<typename Function>
+    void For(std::size_t count, unsigned threadCount, const Function& function, std::size_t grainSize = DefaultGrainSize)
+    {
+        if(threadCount == 1 || count <= grainSize)
+        {
+            if(count > 0) function(std::size_t(0), count);
+            return;
+        }
+
+        ThreadPool::Global().For(count, threadCount == 0 ? grainSize : (count + threadCount - 1) / threadCount, function);
+    }
+
+    // Removes elements from [0, count) in place and returns how many are left, keeping their order. compact(begin, end)
+    // packs the elements it keeps from [begin, end) to begin and returns how many it kept; chunks of that run under the
+    // For policy above, with their size rounded up to a multiple of alignment, and then move(from, size, to) slides
+    // each chunk's survivors down over the gaps the chunks before it left.
+    template<typename CompactRange, typename Move>
+    std::size_t Compact(std::size_t count, unsigned threadCount, const CompactRange& compact, const Move& move,
+        std::size_t grainSize = DefaultGrainSize, std::size_t alignment = 1)
+    {
+        constexpr std::size_t MaxChunks = 64;
+        if(threadCount == 1 || count <= grainSize) return compact(std::size_t(0), count);
+
+        const std::size_t chunkCount = std::min(MaxChunks, ChunkCount(threadCount));
+        const std::size_t chunkSize = ((count + chunkCount - 1) / chunkCount + alignment - 1) / alignment * alignment;
+        std::size_t kept[MaxChunks];
+        For(chunkCount, [&](std::size_t beginChunk, std::size_t endChunk)
+        {
+            for(std::size_t chunk = beginChunk; chunk < endChunk; chunk++)
+            {
+                const std::size_t begin = std::min(count, chunk * chunkSize);
+                kept[chunk] = compact(begin, std::min(count, begin + chunkSize));
+            }
+        }, 1);
+
+        // Rounding chunkSize up can leave trailing chunks empty, and their start past count.
+        std::size_t total = 0;
+        for(std::size_t chunk = 0; chunk < chunkCount; chunk++)
+        {
+            if(kept[chunk] == 0) continue;
+            const std::size_t begin = std::min(count, chunk * chunkSize);
+            if(begin != total) move(begin, kept[chunk], total);
+            total += kept[chunk];
+        }
+        return total;
+    }
+
+    template<typename T, typename Function>
+    void ForEach(std::span<T> values, const Function& function, std::size_t grainSize = DefaultGrainSize)
+    {
+        For(values.size(), [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t i = begin; i < end; i++) function(values[i]);
+        }, grainSize);
+    }
+
+    // out[i] = function(in[i]); out may alias in.
+    template<typename T, typename U, typename Function>
+    void Transform(std::span<const T> in, std::span<U> out, const Function& function, std::size_t grainSize = DefaultGrainSize)
+    {
+        assert(out.size() >= in.size());
+        For(in.size(), [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t i = begin; i < end; i++) out[i] = function(in[i]);
+        }, grainSize);
+    }
+
+    // Folds values with combine, which must be associative. The input is cut into blocks that depend only on its size
+    // and the grain size, and the block results are combined in order, so the result is the same for any thread count.
+    template<typename T, typename Function>
+    T Reduce(std::span<const T> values, T identity, const Function& combine, std::size_t grainSize = DefaultGrainSize)
+    {
+        constexpr std::size_t MaxBlocks = 256;
+
+        const std::size_t count = values.size();
+        const std::size_t blockSize = std::max({grainSize, std::size_t(1), (count + MaxBlocks - 1) / MaxBlocks});
+        const std::size_t blockCount = (count + blockSize - 1) / blockSize;
+
+        T partials[MaxBlocks];
+        For(blockCount, [&](std::size_t beginBlock, std::size_t endBlock)
+        {
+            for(std::size_t block = beginBlock; block < endBlock; block++)
+            {
+                const std::size_t end = std::min(count, (block + 1) * blockSize);
+                T partial = identity;
+                for(std::size_t i = block * blockSize; i < end; i++) partial = combine(partial, values[i]);
+                partials[block] = partial;
+            }
+        }, 1);
+
+        T result = identity;
+        for(std::size_t block = 0; block < blockCount; block++) result = combine(result, partials[block]);
+        return result;
+    }
+}
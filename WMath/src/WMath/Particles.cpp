@@ -0,0 +1,137 @@
+﻿#include "Particles.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+#include "WMath/Parallel.hpp"
+
+namespace
+{
+    constexpr std::size_t CompactBlockSize = 1024;
+
+    // Runs kernel(positions, velocities, accelerations, begin, end) over one axis at a time, so each loop touches
+    // three streams and stays simple enough for the compiler to vectorize, then counts the lifetimes down.
+    template<typename Kernel>
+    void Integrate(WMath::ParticleBuffer& particles, float deltaTime, unsigned threadCount, const Kernel& kernel)
+    {
+        assert(particles.velocities.Size() == particles.Size() && particles.accelerations.Size() == particles.Size());
+        assert(particles.lifetimes.size() == particles.Size());
+
+        float* const positions[] = {particles.positions.x.data(), particles.positions.y.data(), particles.positions.z.data()};
+        float* const velocities[] = {particles.velocities.x.data(), particles.velocities.y.data(), particles.velocities.z.data()};
+        const float* const accelerations[] = {particles.accelerations.x.data(), particles.accelerations.y.data(), particles.accelerations.z.data()};
+        float* const lifetimes = particles.lifetimes.data();
+        WMath::Parallel::For(particles.Size(), threadCount, [&](std::size_t begin, std::size_t end)
+        {
+            for(int axis = 0; axis < 3; axis++) kernel(axis, positions[axis], velocities[axis], accelerations[axis], begin, end);
+            for(std::size_t i = begin; i < end; i++) lifetimes[i] -= deltaTime;
+        });
+    }
+}
+
+std::size_t WMath::ParticleBuffer::Compact(unsigned threadCount)
+{
+    const std::size_t count = Size();
+    float* const streams[] = {positions.x.data(), positions.y.data(), positions.z.data(), velocities.x.data(), velocities.y.data(),
+        velocities.z.data(), accelerations.x.data(), accelerations.y.data(), accelerations.z.data(), lifetimes.data()};
+
+    // Within a chunk, the kept indices of a block are found once and every stream is then gathered down with loads that
+    // do not depend on each other.
+    const std::size_t kept = Parallel::Compact(count, threadCount, [&](std::size_t begin, std::size_t end)
+    {
+        std::uint32_t indices[CompactBlockSize];
+        std::size_t write = begin;
+        for(std::size_t block = begin; block < end; block += CompactBlockSize)
+        {
+            const std::uint32_t blockSize = static_cast<std::uint32_t>(std::min(CompactBlockSize, end - block));
+            std::uint32_t found = 0;
+            for(std::uint32_t i = 0; i < blockSize; i++)
+            {
+                indices[found] = i;
+                found += lifetimes[block + i] > 0;
+            }
+
+            if(found == blockSize && write == block)
+            {
+                write += found;
+                continue;
+            }
+            for(float* stream : streams)
+            {
+                const float* const source = stream + block;
+                float* const destination = stream + write;
+                for(std::uint32_t i = 0; i < found; i++) destination[i] = source[indices[i]];
+            }
+            write += found;
+        }
+        return write - begin;
+    }, [&](std::size_t from, std::size_t size, std::size_t to)
+    {
+        for(float* stream : streams) std::copy(stream + from, stream + from + size, stream + to);
+    });
+
+    Resize(kept);
+    return count - kept;
+}
+
+void WMath::Integration::ExplicitEuler(ParticleBuffer& particles, float deltaTime, unsigned threadCount)
+{
+    Integrate(particles, deltaTime, threadCount, [=](int, float* positions, float* velocities, const float* accelerations,
+        std::size_t begin, std::size_t end)
+    {
+        for(std::size_t i = begin; i < end; i++)
+        {
+            positions[i] += velocities[i] * deltaTime;
+            velocities[i] += accelerations[i] * deltaTime;
+        }
+    });
+}
+
+void WMath::Integration::SemiImplicitEuler(ParticleBuffer& particles, float deltaTime, unsigned threadCount)
+{
+    Integrate(particles, deltaTime, threadCount, [=](int, float* positions, float* velocities, const float* accelerations,
+        std::size_t begin, std::size_t end)
+    {
+        for(std::size_t i = begin; i < end; i++)
+        {
+            velocities[i] += accelerations[i] * deltaTime;
+            positions[i] += velocities[i] * deltaTime;
+        }
+    });
+}
+
+void WMath::Integration::Verlet(ParticleBuffer& particles, float deltaTime, unsigned threadCount)
+{
+    const float halfSquared = 0.5f * deltaTime * deltaTime;
+    Integrate(particles, deltaTime, threadCount, [=](int, float* positions, float* velocities, const float* accelerations,
+        std::size_t begin, std::size_t end)
+    {
+        for(std::size_t i = begin; i < end; i++)
+        {
+            positions[i] += velocities[i] * deltaTime + accelerations[i] * halfSquared;
+            velocities[i] += accelerations[i] * deltaTime;
+        }
+    });
+}
+
+void WMath::Integration::DampedSpring(ParticleBuffer& particles, const Vector3Array& targets, float stiffness, float damping,
+    float deltaTime, unsigned threadCount)
+{
+    assert(targets.Size() == particles.Size());
+
+    // Backward Euler on the spring: solving v' = v + dt * (a + k * (target - x - dt * v') - c * v') for v'.
+    const float inverseDenominator = 1.0f / (1.0f + deltaTime * damping + deltaTime * deltaTime * stiffness);
+    const float pull = deltaTime * stiffness;
+    const float* const targetAxes[] = {targets.x.data(), targets.y.data(), targets.z.data()};
+    Integrate(particles, deltaTime, threadCount, [=](int axis, float* positions, float* velocities, const float* accelerations,
+        std::size_t begin, std::size_t end)
+    {
+        const float* const target = targetAxes[axis];
+        for(std::size_t i = begin; i < end; i++)
+        {
+            velocities[i] = (velocities[i] + deltaTime * accelerations[i] + pull * (target[i] - positions[i])) * inverseDenominator;
+            positions[i] += velocities[i] * deltaTime;
+        }
+    });
+}
@@ -0,0 +1,91 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <limits>
+#include "WMath/Vector3.hpp"
+#include "WMath/Vector3Array.hpp"
+
+namespace WMath
+{
+    // Structure-of-arrays particle state. Every stream has one entry per particle; lifetimes count down by the step of
+    // each integration and Compact drops the particles whose lifetime has run out.
+    class ParticleBuffer
+    {
+    public:
+        Vector3Array positions;
+        Vector3Array velocities;
+        Vector3Array accelerations;
+        Vector3Array::Stream lifetimes;
+
+        ParticleBuffer() = default;
+        explicit ParticleBuffer(std::size_t size) : positions(size), velocities(size), accelerations(size),
+            lifetimes(size, std::numeric_limits<float>::infinity()) {}
+
+        std::size_t Size() const
+        {
+            return positions.Size();
+        }
+        bool Empty() const
+        {
+            return positions.Empty();
+        }
+
+        // New particles are at rest at the origin and never expire.
+        void Resize(std::size_t size)
+        {
+            positions.Resize(size);
+            velocities.Resize(size);
+            accelerations.Resize(size);
+            lifetimes.resize(size, std::numeric_limits<float>::infinity());
+        }
+        void Reserve(std::size_t capacity)
+        {
+            positions.Reserve(capacity);
+            velocities.Reserve(capacity);
+            accelerations.Reserve(capacity);
+            lifetimes.reserve(capacity);
+        }
+        void Clear()
+        {
+            positions.Clear();
+            velocities.Clear();
+            accelerations.Clear();
+            lifetimes.clear();
+        }
+
+        std::size_t Add(const Vector3& position, const Vector3& velocity = Vector3::Zero(), const Vector3& acceleration = Vector3::Zero(),
+            float lifetime = std::numeric_limits<float>::infinity())
+        {
+            positions.PushBack(position);
+            velocities.PushBack(velocity);
+            accelerations.PushBack(acceleration);
+            lifetimes.push_back(lifetime);
+            return lifetimes.size() - 1;
+        }
+
+        // Removes the particles whose lifetime is no longer positive, keeping the order of the others, and returns how
+        // many were removed. threadCount works as for the integrators.
+        std::size_t Compact(unsigned threadCount = 1);
+    };
+}
+
+namespace WMath::Integration
+{
+    // Fused steps over a whole ParticleBuffer: each reads and writes every stream once and counts the lifetimes down by
+    // deltaTime. A threadCount of 1 stays on the calling thread, 0 lets ThreadPool::Global() balance the work, and any
+    // other value splits the particles into that many chunks.
+
+    // position += velocity * dt, then velocity += acceleration * dt. First order and gains energy on orbits and
+    // springs; mostly useful as a reference.
+    void ExplicitEuler(ParticleBuffer& particles, float deltaTime, unsigned threadCount = 1);
+    // velocity += acceleration * dt, then position += velocity * dt. Symplectic, so orbits and oscillations stay bounded.
+    void SemiImplicitEuler(ParticleBuffer& particles, float deltaTime, unsigned threadCount = 1);
+    // position += velocity * dt + acceleration * dt * dt / 2, then velocity += acceleration * dt. This is velocity
+    // Verlet with the acceleration held over the step, so ballistic paths under constant accelerations such as gravity
+    // come out exact for any step.
+    void Verlet(ParticleBuffer& particles, float deltaTime, unsigned threadCount = 1);
+    // Pulls every particle towards targets[i] with acceleration stiffness * (target - position) - damping * velocity,
+    // on top of its own acceleration. The step is implicit in the spring, so it stays stable for any stiffness and step.
+    void DampedSpring(ParticleBuffer& particles, const Vector3Array& targets, float stiffness, float damping, float deltaTime,
+        unsigned threadCount = 1);
+}
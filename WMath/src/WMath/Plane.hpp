@@ -0,0 +1,57 @@
+﻿#pragma once
+
+#include <limits>
+#include "WMath/Ray.hpp"
+#include "WMath/Vector3.hpp"
+
+namespace WMath
+{
+    // Points p on the plane satisfy Dot(normal, p) + distance == 0; normal has unit length and points to the positive
+    // side.
+    struct Plane
+    {
+        Vector3 normal;
+        float distance;
+
+        constexpr Plane() : normal(Vector3::Up()), distance(0) {}
+        constexpr Plane(const Vector3& normal, float distance) : normal(normal), distance(distance) {}
+        Plane(const Vector3& normal, const Vector3& point) : normal(normal.Normalized())
+        {
+            distance = -Vector3::Dot(this->normal, point);
+        }
+        // Counter-clockwise winding seen from the positive side.
+        Plane(const Vector3& a, const Vector3& b, const Vector3& c) : Plane(Vector3::Cross(b - a, c - a), a) {}
+
+        constexpr Plane Flipped() const
+        {
+            return {normal * -1.0f, -distance};
+        }
+
+        // Signed: positive on the side the normal points to.
+        constexpr float GetDistanceToPoint(const Vector3& point) const
+        {
+            return Vector3::Dot(normal, point) + distance;
+        }
+        constexpr bool GetSide(const Vector3& point) const
+        {
+            return GetDistanceToPoint(point) > 0;
+        }
+        constexpr Vector3 ClosestPointOnPlane(const Vector3& point) const
+        {
+            return point - normal * GetDistanceToPoint(point);
+        }
+
+        // Hits from either side; rays parallel to the plane never hit.
+        bool Raycast(const Ray& ray, float& distance, float maxDistance = std::numeric_limits<float>::infinity()) const
+        {
+            const float approach = Vector3::Dot(normal, ray.direction);
+            if(approach == 0) return false;
+
+            const float enter = -GetDistanceToPoint(ray.origin) / approach;
+            if(enter < 0 || enter > maxDistance) return false;
+
+            distance = enter;
+            return true;
+        }
+    };
+}
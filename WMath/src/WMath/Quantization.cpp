@@ -0,0 +1,183 @@
+﻿#include "Quantization.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+namespace
+{
+    typedef WMath::Simd::NativeLanes Lanes;
+    typedef Lanes::Float Float;
+    typedef Lanes::Int Int;
+
+    // Calls function(lane) for the first count lanes; full packets get a constant trip count the compiler can unroll.
+    template<typename Function>
+    void ForEachLane(std::size_t count, const Function& function)
+    {
+        if(count == Lanes::Width)
+        {
+            for(std::size_t lane = 0; lane < Lanes::Width; lane++) function(lane);
+        }
+        else
+        {
+            for(std::size_t lane = 0; lane < count; lane++) function(lane);
+        }
+    }
+
+    void Store(std::uint32_t* out, Int codes, std::size_t count)
+    {
+        if(count == Lanes::Width)
+        {
+            Lanes::StoreInt(reinterpret_cast<std::int32_t*>(out), codes);
+            return;
+        }
+        std::int32_t stored[Lanes::Width];
+        Lanes::StoreInt(stored, codes);
+        for(std::size_t lane = 0; lane < count; lane++) out[lane] = static_cast<std::uint32_t>(stored[lane]);
+    }
+
+    Int Load(const std::uint32_t* in, std::size_t count)
+    {
+        if(count == Lanes::Width) return Lanes::LoadInt(reinterpret_cast<const std::int32_t*>(in));
+        std::int32_t loaded[Lanes::Width] = {};
+        for(std::size_t lane = 0; lane < count; lane++) loaded[lane] = static_cast<std::int32_t>(in[lane]);
+        return Lanes::LoadInt(loaded);
+    }
+
+    // Interleaves count lanes of Components floats back into packed elements.
+    template<std::size_t Components>
+    void Store(float* out, const Float (&values)[Components], std::size_t count)
+    {
+        float transposed[Components][Lanes::Width];
+        for(std::size_t component = 0; component < Components; component++) Lanes::Store(transposed[component], values[component]);
+        ForEachLane(count, [&](std::size_t lane)
+        {
+            for(std::size_t component = 0; component < Components; component++) out[lane * Components + component] = transposed[component][lane];
+        });
+    }
+
+    Int Mask(std::uint32_t bits)
+    {
+        return Lanes::SetInt(static_cast<std::int32_t>((1u << bits) - 1));
+    }
+
+    // Encodes packets of directions to lanes of u | v << Bits.
+    template<int Bits, typename Output>
+    void EncodeOctahedral(std::span<const WMath::Vector3> directions, Output* out)
+    {
+        constexpr float levels = static_cast<float>((1u << Bits) - 1);
+        for(std::size_t i = 0; i < directions.size(); i += Lanes::Width)
+        {
+            const std::size_t count = std::min<std::size_t>(Lanes::Width, directions.size() - i);
+            Float values[3];
+            WMath::Simd::LoadTransposed<Lanes>(&directions[i].x, count, values);
+            Int u, v;
+            WMath::Quantization::Detail::EncodeOctahedral<Lanes>(values[0], values[1], values[2], levels, u, v);
+            const Int codes = Lanes::IntOr(u, Lanes::template IntShiftLeft<Bits>(v));
+            if constexpr(sizeof(Output) == sizeof(std::uint32_t)) Store(out + i, codes, count);
+            else
+            {
+                std::uint32_t stored[Lanes::Width];
+                Store(stored, codes, Lanes::Width);
+                ForEachLane(count, [&](std::size_t lane) { out[i + lane] = static_cast<Output>(stored[lane]); });
+            }
+        }
+    }
+
+    template<int Bits, typename Input>
+    void DecodeOctahedral(std::span<const Input> codes, WMath::Vector3* out)
+    {
+        constexpr float levels = static_cast<float>((1u << Bits) - 1);
+        for(std::size_t i = 0; i < codes.size(); i += Lanes::Width)
+        {
+            const std::size_t count = std::min<std::size_t>(Lanes::Width, codes.size() - i);
+            Int packed;
+            if constexpr(sizeof(Input) == sizeof(std::uint32_t)) packed = Load(codes.data() + i, count);
+            else
+            {
+                std::uint32_t widened[Lanes::Width] = {};
+                ForEachLane(count, [&](std::size_t lane) { widened[lane] = codes[i + lane]; });
+                packed = Load(widened, Lanes::Width);
+            }
+            Float values[3];
+            WMath::Quantization::Detail::DecodeOctahedral<Lanes>(Lanes::IntAnd(packed, Mask(Bits)), Lanes::template IntShiftRight<Bits>(packed),
+                levels, values[0], values[1], values[2]);
+            Store(&out[i].x, values, count);
+        }
+    }
+}
+
+void WMath::Quantization::EncodeOctahedral16(std::span<const Vector3> directions, std::span<std::uint16_t> out)
+{
+    assert(out.size() >= directions.size());
+    ::EncodeOctahedral<8>(directions, out.data());
+}
+
+void WMath::Quantization::DecodeOctahedral16(std::span<const std::uint16_t> codes, std::span<Vector3> out)
+{
+    assert(out.size() >= codes.size());
+    ::DecodeOctahedral<8>(codes, out.data());
+}
+
+void WMath::Quantization::EncodeOctahedral32(std::span<const Vector3> directions, std::span<std::uint32_t> out)
+{
+    assert(out.size() >= directions.size());
+    ::EncodeOctahedral<16>(directions, out.data());
+}
+
+void WMath::Quantization::DecodeOctahedral32(std::span<const std::uint32_t> codes, std::span<Vector3> out)
+{
+    assert(out.size() >= codes.size());
+    ::DecodeOctahedral<16>(codes, out.data());
+}
+
+// The fixed-point codecs are a multiply and a round per axis, which compilers vectorize straight from these loops,
+// including the transposes; explicit lanes measured slower.
+
+void WMath::Quantization::PositionCodec::Encode32(std::span<const Vector3> positions, std::span<std::uint32_t> out) const
+{
+    assert(out.size() >= positions.size());
+    for(std::size_t i = 0; i < positions.size(); i++) out[i] = Encode32(positions[i]);
+}
+
+void WMath::Quantization::PositionCodec::Decode32(std::span<const std::uint32_t> codes, std::span<Vector3> out) const
+{
+    assert(out.size() >= codes.size());
+    for(std::size_t i = 0; i < codes.size(); i++) out[i] = Decode32(codes[i]);
+}
+
+void WMath::Quantization::PositionCodec::Encode48(std::span<const Vector3> positions, std::span<PackedPosition48> out) const
+{
+    assert(out.size() >= positions.size());
+    for(std::size_t i = 0; i < positions.size(); i++) out[i] = Encode48(positions[i]);
+}
+
+void WMath::Quantization::PositionCodec::Decode48(std::span<const PackedPosition48> codes, std::span<Vector3> out) const
+{
+    assert(out.size() >= codes.size());
+    for(std::size_t i = 0; i < codes.size(); i++) out[i] = Decode48(codes[i]);
+}
+
+void WMath::Quantization::PositionCodec::Encode64(std::span<const Vector3> positions, std::span<std::uint64_t> out) const
+{
+    assert(out.size() >= positions.size());
+    for(std::size_t i = 0; i < positions.size(); i++) out[i] = Encode64(positions[i]);
+}
+
+void WMath::Quantization::PositionCodec::Decode64(std::span<const std::uint64_t> codes, std::span<Vector3> out) const
+{
+    assert(out.size() >= codes.size());
+    for(std::size_t i = 0; i < codes.size(); i++) out[i] = Decode64(codes[i]);
+}
+
+void WMath::Quantization::Vector2Codec::Encode(std::span<const Vector2> values, std::span<std::uint32_t> out) const
+{
+    assert(out.size() >= values.size());
+    for(std::size_t i = 0; i < values.size(); i++) out[i] = Encode(values[i]);
+}
+
+void WMath::Quantization::Vector2Codec::Decode(std::span<const std::uint32_t> codes, std::span<Vector2> out) const
+{
+    assert(out.size() >= codes.size());
+    for(std::size_t i = 0; i < codes.size(); i++) out[i] = Decode(codes[i]);
+}
@@ -0,0 +1,296 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "WMath/AABB.hpp"
+#include "WMath/FastMath.hpp"
+#include "WMath/Simd.hpp"
+#include "WMath/Vector2.hpp"
+#include "WMath/Vector3.hpp"
+
+namespace WMath::Quantization::Detail
+{
+    // Kernels shared by the scalar codecs below and the span batches; L is a lane set from Simd.hpp.
+
+    // Rounds value, clamped to [0, levels], to the nearest integer level. Inputs must not be NaN.
+    template<typename L>
+    typename L::Int ToLevel(typename L::Float value, float levels)
+    {
+        const typename L::Float clamped = L::Min(L::Max(value, L::Set(0.0f)), L::Set(levels));
+        return L::ToInt(L::Add(clamped, L::Set(0.5f)));
+    }
+
+    template<typename L>
+    typename L::Int Quantize(typename L::Float value, float min, float inverseStep, float levels)
+    {
+        return ToLevel<L>(L::Mul(L::Sub(value, L::Set(min)), L::Set(inverseStep)), levels);
+    }
+
+    template<typename L>
+    typename L::Float Dequantize(typename L::Int level, float min, float step)
+    {
+        return L::Add(L::Set(min), L::Mul(L::ToFloat(level), L::Set(step)));
+    }
+
+    // Projects the direction onto the octahedron |x| + |y| + |z| = 1 and unfolds the lower half over the corners of
+    // the upper one (Cigolle et al., "A Survey of Efficient Representations for Independent Unit Vectors").
+    template<typename L>
+    void EncodeOctahedral(typename L::Float x, typename L::Float y, typename L::Float z, float levels,
+        typename L::Int& u, typename L::Int& v)
+    {
+        typedef typename L::Float Float;
+
+        const Float length = L::Add(L::Add(L::Abs(x), L::Abs(y)), L::Abs(z));
+        const Float inverseLength = L::Div(L::Set(1.0f), L::Max(length, L::Set(std::numeric_limits<float>::min())));
+        Float projectedX = L::Mul(x, inverseLength);
+        Float projectedY = L::Mul(y, inverseLength);
+
+        const typename L::Mask lower = L::Less(z, L::Set(0.0f));
+        const Float foldedX = Fast::Detail::CopySign<L>(L::Sub(L::Set(1.0f), L::Abs(projectedY)), projectedX);
+        const Float foldedY = Fast::Detail::CopySign<L>(L::Sub(L::Set(1.0f), L::Abs(projectedX)), projectedY);
+        projectedX = L::Select(lower, foldedX, projectedX);
+        projectedY = L::Select(lower, foldedY, projectedY);
+
+        const Float half = L::Set(0.5f * levels);
+        u = ToLevel<L>(L::Add(L::Mul(projectedX, half), half), levels);
+        v = ToLevel<L>(L::Add(L::Mul(projectedY, half), half), levels);
+    }
+
+    template<typename L>
+    void DecodeOctahedral(typename L::Int u, typename L::Int v, float levels,
+        typename L::Float& x, typename L::Float& y, typename L::Float& z)
+    {
+        typedef typename L::Float Float;
+
+        const Float scale = L::Set(2.0f / levels);
+        x = L::Sub(L::Mul(L::ToFloat(u), scale), L::Set(1.0f));
+        y = L::Sub(L::Mul(L::ToFloat(v), scale), L::Set(1.0f));
+        z = L::Sub(L::Sub(L::Set(1.0f), L::Abs(x)), L::Abs(y));
+
+        // Folding the corners back only moves points with z < 0, by exactly the amount z is below zero.
+        const Float fold = L::Max(L::Sub(L::Set(0.0f), z), L::Set(0.0f));
+        x = L::Sub(x, Fast::Detail::CopySign<L>(fold, x));
+        y = L::Sub(y, Fast::Detail::CopySign<L>(fold, y));
+
+        const Float inverseLength = Fast::Detail::InvSqrt<L>(L::Add(L::Add(L::Mul(x, x), L::Mul(y, y)), L::Mul(z, z)));
+        x = L::Mul(x, inverseLength);
+        y = L::Mul(y, inverseLength);
+        z = L::Mul(z, inverseLength);
+    }
+
+    // One axis of a fixed-point grid with levels + 1 points spread evenly over [min, min + size].
+    struct Axis
+    {
+        float min = 0.0f;
+        float levels = 0.0f;
+        float step = 0.0f;
+        float inverseStep = 0.0f;
+
+        Axis() = default;
+        Axis(float min, float size, int bits) : min(min), levels(static_cast<float>((1u << bits) - 1))
+        {
+            step = size / levels;
+            inverseStep = size > 0.0f ? levels / size : 0.0f;
+        }
+
+        std::uint32_t Encode(float value) const
+        {
+            return static_cast<std::uint32_t>(Quantize<Simd::ScalarLanes>(value, min, inverseStep, levels));
+        }
+        float Decode(std::uint32_t level) const
+        {
+            return Dequantize<Simd::ScalarLanes>(static_cast<std::int32_t>(level), min, step);
+        }
+
+        // Half a step, plus the float rounding of the arithmetic at the largest coordinate on the axis.
+        float MaxError() const
+        {
+            return 0.5f * step + 2.0f * Epsilon * Max(Abs(min), Abs(min + levels * step));
+        }
+    };
+}
+
+namespace WMath::Quantization
+{
+    // Octahedral unit vectors: the 16-bit form stores 8 bits per coordinate and the 32-bit form 16. Over the whole
+    // sphere the decoded direction is off by at most 0.017 radians (0.95 degrees) for 16 bits and 6.5e-5 radians for
+    // 32 bits; decoded vectors are unit length to within 1e-6. Inputs need not be normalized but must be non-zero.
+
+    inline std::uint16_t EncodeOctahedral16(const Vector3& direction)
+    {
+        std::int32_t u, v;
+        Detail::EncodeOctahedral<Simd::ScalarLanes>(direction.x, direction.y, direction.z, 255.0f, u, v);
+        return static_cast<std::uint16_t>(u | v << 8);
+    }
+
+    inline Vector3 DecodeOctahedral16(std::uint16_t code)
+    {
+        Vector3 direction;
+        Detail::DecodeOctahedral<Simd::ScalarLanes>(code & 0xFF, code >> 8, 255.0f, direction.x, direction.y, direction.z);
+        return direction;
+    }
+
+    inline std::uint32_t EncodeOctahedral32(const Vector3& direction)
+    {
+        std::int32_t u, v;
+        Detail::EncodeOctahedral<Simd::ScalarLanes>(direction.x, direction.y, direction.z, 65535.0f, u, v);
+        return static_cast<std::uint32_t>(u) | static_cast<std::uint32_t>(v) << 16;
+    }
+
+    inline Vector3 DecodeOctahedral32(std::uint32_t code)
+    {
+        Vector3 direction;
+        Detail::DecodeOctahedral<Simd::ScalarLanes>(static_cast<std::int32_t>(code & 0xFFFF), static_cast<std::int32_t>(code >> 16),
+            65535.0f, direction.x, direction.y, direction.z);
+        return direction;
+    }
+
+    void EncodeOctahedral16(std::span<const Vector3> directions, std::span<std::uint16_t> out);
+    void DecodeOctahedral16(std::span<const std::uint16_t> codes, std::span<Vector3> out);
+    void EncodeOctahedral32(std::span<const Vector3> directions, std::span<std::uint32_t> out);
+    void DecodeOctahedral32(std::span<const std::uint32_t> codes, std::span<Vector3> out);
+
+    struct PackedPosition48
+    {
+        std::uint16_t x;
+        std::uint16_t y;
+        std::uint16_t z;
+    };
+
+    static_assert(sizeof(PackedPosition48) == 6);
+
+    // Fixed-point positions relative to a box: 11/11/10 bits per axis in 32 bits, 16 in 48 and 21 in 64. Points are
+    // clamped into the box, and a point inside it decodes to within GetMaxError() of itself on every axis: half a grid
+    // step, size / (2 * (2^bits - 1)), plus float rounding, which only matters at 64 bits on boxes far from the origin.
+    class PositionCodec
+    {
+    public:
+        static constexpr int Bits32[3] = {11, 11, 10};
+        static constexpr int Bits48 = 16;
+        static constexpr int Bits64 = 21;
+
+        PositionCodec() = default;
+        explicit PositionCodec(const AABB& bounds) : bounds(bounds)
+        {
+            const Vector3 size = bounds.Size();
+            for(int axis = 0; axis < 3; axis++)
+            {
+                const float min = axis == 0 ? bounds.min.x : axis == 1 ? bounds.min.y : bounds.min.z;
+                const float extent = axis == 0 ? size.x : axis == 1 ? size.y : size.z;
+                axes32[axis] = Detail::Axis(min, extent, Bits32[axis]);
+                axes48[axis] = Detail::Axis(min, extent, Bits48);
+                axes64[axis] = Detail::Axis(min, extent, Bits64);
+            }
+        }
+
+        const AABB& GetBounds() const
+        {
+            return bounds;
+        }
+
+        Vector3 GetMaxError32() const
+        {
+            return MaxError(axes32);
+        }
+        Vector3 GetMaxError48() const
+        {
+            return MaxError(axes48);
+        }
+        Vector3 GetMaxError64() const
+        {
+            return MaxError(axes64);
+        }
+
+        std::uint32_t Encode32(const Vector3& position) const
+        {
+            return axes32[0].Encode(position.x) | axes32[1].Encode(position.y) << Bits32[0] |
+                axes32[2].Encode(position.z) << (Bits32[0] + Bits32[1]);
+        }
+        Vector3 Decode32(std::uint32_t code) const
+        {
+            return {axes32[0].Decode(code & 0x7FF), axes32[1].Decode(code >> Bits32[0] & 0x7FF), axes32[2].Decode(code >> (Bits32[0] + Bits32[1]))};
+        }
+
+        PackedPosition48 Encode48(const Vector3& position) const
+        {
+            return {static_cast<std::uint16_t>(axes48[0].Encode(position.x)), static_cast<std::uint16_t>(axes48[1].Encode(position.y)),
+                static_cast<std::uint16_t>(axes48[2].Encode(position.z))};
+        }
+        Vector3 Decode48(const PackedPosition48& code) const
+        {
+            return {axes48[0].Decode(code.x), axes48[1].Decode(code.y), axes48[2].Decode(code.z)};
+        }
+
+        std::uint64_t Encode64(const Vector3& position) const
+        {
+            return static_cast<std::uint64_t>(axes64[0].Encode(position.x)) | static_cast<std::uint64_t>(axes64[1].Encode(position.y)) << Bits64 |
+                static_cast<std::uint64_t>(axes64[2].Encode(position.z)) << (2 * Bits64);
+        }
+        Vector3 Decode64(std::uint64_t code) const
+        {
+            constexpr std::uint64_t mask = (1ull << Bits64) - 1;
+            return {axes64[0].Decode(static_cast<std::uint32_t>(code & mask)), axes64[1].Decode(static_cast<std::uint32_t>(code >> Bits64 & mask)),
+                axes64[2].Decode(static_cast<std::uint32_t>(code >> (2 * Bits64) & mask))};
+        }
+
+        void Encode32(std::span<const Vector3> positions, std::span<std::uint32_t> out) const;
+        void Decode32(std::span<const std::uint32_t> codes, std::span<Vector3> out) const;
+        void Encode48(std::span<const Vector3> positions, std::span<PackedPosition48> out) const;
+        void Decode48(std::span<const PackedPosition48> codes, std::span<Vector3> out) const;
+        void Encode64(std::span<const Vector3> positions, std::span<std::uint64_t> out) const;
+        void Decode64(std::span<const std::uint64_t> codes, std::span<Vector3> out) const;
+
+    private:
+        AABB bounds;
+        Detail::Axis axes32[3];
+        Detail::Axis axes48[3];
+        Detail::Axis axes64[3];
+
+        static Vector3 MaxError(const Detail::Axis (&axes)[3])
+        {
+            return Vector3(axes[0].MaxError(), axes[1].MaxError(), axes[2].MaxError());
+        }
+    };
+
+    // Fixed-point Vector2 with 16 bits per axis over [min, max], x in the low half. Error bounds as for PositionCodec.
+    class Vector2Codec
+    {
+    public:
+        static constexpr int Bits = 16;
+
+        Vector2Codec() = default;
+        Vector2Codec(const Vector2& min, const Vector2& max) : min(min), max(max), axes{{min.x, max.x - min.x, Bits}, {min.y, max.y - min.y, Bits}} {}
+
+        const Vector2& GetMin() const
+        {
+            return min;
+        }
+        const Vector2& GetMax() const
+        {
+            return max;
+        }
+        Vector2 GetMaxError() const
+        {
+            return Vector2(axes[0].MaxError(), axes[1].MaxError());
+        }
+
+        std::uint32_t Encode(const Vector2& value) const
+        {
+            return axes[0].Encode(value.x) | axes[1].Encode(value.y) << Bits;
+        }
+        Vector2 Decode(std::uint32_t code) const
+        {
+            return {axes[0].Decode(code & 0xFFFF), axes[1].Decode(code >> Bits)};
+        }
+
+        void Encode(std::span<const Vector2> values, std::span<std::uint32_t> out) const;
+        void Decode(std::span<const std::uint32_t> codes, std::span<Vector2> out) const;
+
+    private:
+        Vector2 min;
+        Vector2 max;
+        Detail::Axis axes[2];
+    };
+}
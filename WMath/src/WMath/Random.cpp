@@ -1,66 +1,97 @@
 ﻿#include "Random.hpp"
 
-void WMath::Random::Seed(SeedType seed)
+#include <cassert>
+
+#include "WMath/Parallel.hpp"
+
+namespace
 {
-    currentSeed = seed;
-    if(generators.ContainsKey(seed)) return;
+    // A row of noise is expensive enough to be worth a thread on its own.
+    template<typename Function>
+    void ForEachRow(std::size_t rows, unsigned threadCount, const Function& function)
+    {
+        WMath::Parallel::For(rows, threadCount, [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t row = begin; row < end; row++) function(row);
+        }, 1);
+    }
+}
 
-    generators[seed] = Generator(seed);
+void WMath::RandomBase::Seed(SeedType seed)
+{
+    masterSeed.store(seed, std::memory_order_relaxed);
+    generation.fetch_add(1, std::memory_order_release);
 }
 
-WMath::Random::SeedType WMath::Random::GetSeed()
+WMath::RandomBase::SeedType WMath::RandomBase::GetSeed()
 {
-    return currentSeed;
+    return masterSeed.load(std::memory_order_relaxed);
 }
 
-void WMath::Random::SetNoiseSeed(int seed)
+WMath::RandomBase::SeedType WMath::RandomBase::DeriveSeed(SeedType seed, unsigned long long streamIndex)
 {
-    noiseSeed = seed;
-    noise.SetSeed(seed);
+    SplitMix64 mixer(seed);
+    mixer.Discard(streamIndex);
+    return mixer();
 }
 
-int WMath::Random::GetNoiseSeed()
+void WMath::RandomBase::SetNoiseSeed(int seed)
 {
-    return noiseSeed;
+    noise.SetSeed(seed);
 }
 
-int WMath::Random::GetValue(int min, int max)
+int WMath::RandomBase::GetNoiseSeed()
 {
-    std::uniform_int_distribution distribution(min, max);
-    return distribution(generators[currentSeed]);
+    return noise.GetSeed();
 }
 
-float WMath::Random::GetValue(float min, float max)
+float WMath::RandomBase::GetNoise(float x, float y)
 {
-    std::uniform_real_distribution distribution(min, max);
-    return distribution(generators[currentSeed]);
+    return noise.GetNoise(x, y);
 }
 
-template <typename T>
-T WMath::Random::GetValue(T min, T max)
+float WMath::RandomBase::GetNoise(float x, float y, float z)
 {
-    std::uniform_real_distribution<T> distribution(min, max);
-    return distribution(generators[currentSeed]);
+    return noise.GetNoise(x, y, z);
 }
 
-WMath::Vector2 WMath::Random::GetVector2(float min, float max)
+void WMath::RandomBase::GenerateNoise(std::span<const Vector2> points, std::span<float> out)
 {
-    return {GetValue(min, max), GetValue(min, max)};
+    noise.GetNoise(points, out);
 }
 
-WMath::Vector3 WMath::Random::GetVector3(float min, float max)
+void WMath::RandomBase::GenerateNoise(std::span<const Vector3> points, std::span<float> out)
 {
-    return {GetValue(min, max), GetValue(min, max), GetValue(min, max)};
+    noise.GetNoise(points, out);
 }
 
-float WMath::Random::GetNoise(float x, float y)
+void WMath::RandomBase::GenerateNoiseGrid2D(const Vector2& origin, const Vector2& step, int width, int height,
+    std::span<float> out, unsigned threadCount)
 {
-    noise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2S);
-    return noise.GetNoise(x, y);
+    assert(width >= 0 && height >= 0);
+    const std::size_t rowSize = static_cast<std::size_t>(width);
+    const std::size_t rows = static_cast<std::size_t>(height);
+    assert(out.size() >= rowSize * rows);
+    const OpenSimplex2S& source = noise;
+    ForEachRow(rows, threadCount, [&](std::size_t row)
+    {
+        const Vector2 start(origin.x, origin.y + step.y * static_cast<float>(row));
+        source.GetNoiseRow(start, step.x, out.subspan(row * rowSize, rowSize));
+    });
 }
 
-float WMath::Random::GetNoise(float x, float y, float z)
+void WMath::RandomBase::GenerateNoiseGrid3D(const Vector3& origin, const Vector3& step, int width, int height, int depth,
+    std::span<float> out, unsigned threadCount)
 {
-    noise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2S);
-    return noise.GetNoise(x, y, z);
+    assert(width >= 0 && height >= 0 && depth >= 0);
+    const std::size_t rowSize = static_cast<std::size_t>(width);
+    const std::size_t sliceRows = static_cast<std::size_t>(height);
+    const std::size_t rows = sliceRows * static_cast<std::size_t>(depth);
+    assert(out.size() >= rowSize * rows);
+    const OpenSimplex2S& source = noise;
+    ForEachRow(rows, threadCount, [&](std::size_t row)
+    {
+        const Vector3 start(origin.x, origin.y + step.y * static_cast<float>(row % sliceRows), origin.z + step.z * static_cast<float>(row / sliceRows));
+        source.GetNoiseRow(start, step.x, out.subspan(row * rowSize, rowSize));
+    });
 }
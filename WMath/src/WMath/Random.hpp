@@ -1,49 +1,132 @@
 ﻿#pragma once
 
-#include "FastNoiseLite.h"
-
+#include "WMath/OpenSimplex2S.hpp"
+#include "WMath/RandomEngines.hpp"
+#include "WMath/RandomStream.hpp"
 #include "WMath/Vector2.hpp"
 #include "WMath/Vector3.hpp"
-#include "WSTL/containers/Map.hpp"
 
-#include <random>
+#include <atomic>
+#include <span>
 
 namespace WMath
 {
-    class Random
+    class RandomBase
     {
-    private:
-        typedef std::mt19937_64 Generator;
-        typedef unsigned long long SeedType;
-        
     public:
+        typedef unsigned long long SeedType;
+
         static void Seed(SeedType seed);
 
         static SeedType GetSeed();
 
+        static SeedType DeriveSeed(SeedType seed, unsigned long long streamIndex);
+
         static void SetNoiseSeed(int seed);
 
         static int GetNoiseSeed();
 
-        static int GetValue(int min, int max);
+        static float GetNoise(float x, float y);
+
+        static float GetNoise(float x, float y, float z);
+
+        static void GenerateNoise(std::span<const Vector2> points, std::span<float> out);
+
+        static void GenerateNoise(std::span<const Vector3> points, std::span<float> out);
+
+        static void GenerateNoiseGrid2D(const Vector2& origin, const Vector2& step, int width, int height,
+            std::span<float> out, unsigned threadCount = 1);
+
+        static void GenerateNoiseGrid3D(const Vector3& origin, const Vector3& step, int width, int height, int depth,
+            std::span<float> out, unsigned threadCount = 1);
+
+    protected:
+        static inline std::atomic<SeedType> masterSeed = 0;
+        static inline std::atomic<unsigned> generation = 1;
+        static inline std::atomic<unsigned long long> nextStreamIndex = 0;
+
+    private:
+        static inline OpenSimplex2S noise;
+    };
+
+    template<typename Engine>
+    class BasicRandom : public RandomBase
+    {
+    public:
+        typedef BasicRandomStream<Engine> Stream;
+
+        static Stream& GetStream()
+        {
+            ThreadState& state = threadState;
+            if(state.generation != generation.load(std::memory_order_acquire)) state.Reseed();
+            return state.stream;
+        }
 
-        static float GetValue(float min, float max);
+        static int GetValue(int min, int max)
+        {
+            return GetStream().GetValue(min, max);
+        }
+
+        static float GetValue(float min, float max)
+        {
+            return GetStream().GetValue(min, max);
+        }
 
         template<typename T>
-        static T GetValue(T min, T max);
+        static T GetValue(T min, T max)
+        {
+            return GetStream().GetValue(min, max);
+        }
 
-        static Vector2 GetVector2(float min, float max);
+        static Vector2 GetVector2(float min, float max)
+        {
+            return GetStream().GetVector2(min, max);
+        }
 
-        static Vector3 GetVector3(float min, float max);
+        static Vector3 GetVector3(float min, float max)
+        {
+            return GetStream().GetVector3(min, max);
+        }
 
-        static float GetNoise(float x, float y);
+        static void FillUniform(std::span<float> out, float min, float max)
+        {
+            GetStream().FillUniform(out, min, max);
+        }
 
-        static float GetNoise(float x, float y, float z);
+        static void FillUniform(std::span<int> out, int min, int max)
+        {
+            GetStream().FillUniform(out, min, max);
+        }
+
+        static void FillVector2(std::span<Vector2> out, float min, float max)
+        {
+            GetStream().FillVector2(out, min, max);
+        }
+
+        static void FillVector3(std::span<Vector3> out, float min, float max)
+        {
+            GetStream().FillVector3(out, min, max);
+        }
 
     private:
-        static inline WSTL::Map<SeedType, Generator> generators = WSTL::Map<SeedType, Generator>();
-        static inline SeedType currentSeed = 0;
-        static inline int noiseSeed = 0;
-        static inline FastNoiseLite noise;
+        struct ThreadState
+        {
+            Stream stream;
+            unsigned long long streamIndex = nextStreamIndex.fetch_add(1, std::memory_order_relaxed);
+            unsigned generation = 0;
+
+            void Reseed()
+            {
+                generation = RandomBase::generation.load(std::memory_order_acquire);
+                stream.Seed(DeriveSeed(masterSeed.load(std::memory_order_relaxed), streamIndex));
+            }
+        };
+
+        static thread_local ThreadState threadState;
     };
+
+    template<typename Engine>
+    thread_local typename BasicRandom<Engine>::ThreadState BasicRandom<Engine>::threadState;
+
+    typedef BasicRandom<DefaultRandomEngine> Random;
 }
@@ -0,0 +1,289 @@
+﻿#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace WMath
+{
+    class SplitMix64
+    {
+    public:
+        typedef std::uint64_t result_type;
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        constexpr SplitMix64() : SplitMix64(0) {}
+        constexpr explicit SplitMix64(std::uint64_t seed) : state(seed) {}
+
+        constexpr void Seed(std::uint64_t seed)
+        {
+            state = seed;
+        }
+
+        constexpr result_type operator()()
+        {
+            state += Increment;
+            result_type result = state;
+            result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ull;
+            result = (result ^ (result >> 27)) * 0x94D049BB133111EBull;
+            return result ^ (result >> 31);
+        }
+
+        constexpr void Discard(std::uint64_t count)
+        {
+            state += Increment * count;
+        }
+
+        // 2^32 and 2^48 draws ahead.
+        constexpr void Jump()
+        {
+            Discard(1ull << 32);
+        }
+        constexpr void LongJump()
+        {
+            Discard(1ull << 48);
+        }
+
+    private:
+        static constexpr std::uint64_t Increment = 0x9E3779B97F4A7C15ull;
+
+        std::uint64_t state;
+    };
+
+    class Xoshiro256StarStar
+    {
+    public:
+        typedef std::uint64_t result_type;
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        constexpr Xoshiro256StarStar() : Xoshiro256StarStar(0) {}
+        constexpr explicit Xoshiro256StarStar(std::uint64_t seed) : state{}
+        {
+            Seed(seed);
+        }
+
+        constexpr void Seed(std::uint64_t seed)
+        {
+            SplitMix64 seeder(seed);
+            for(std::uint64_t& word : state) word = seeder();
+        }
+
+        constexpr result_type operator()()
+        {
+            const result_type result = RotateLeft(state[1] * 5, 7) * 9;
+            const std::uint64_t t = state[1] << 17;
+
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = RotateLeft(state[3], 45);
+
+            return result;
+        }
+
+        constexpr void Discard(std::uint64_t count)
+        {
+            for(std::uint64_t i = 0; i < count; i++) (*this)();
+        }
+
+        // 2^128 draws ahead, for up to 2^128 non-overlapping streams.
+        constexpr void Jump()
+        {
+            constexpr std::uint64_t polynomial[] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+            Jump(polynomial);
+        }
+        // 2^192 draws ahead, for up to 2^64 starting points that each allow 2^64 Jump() streams.
+        constexpr void LongJump()
+        {
+            constexpr std::uint64_t polynomial[] = {0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull, 0x77710069854EE241ull, 0x39109BB02ACBE635ull};
+            Jump(polynomial);
+        }
+
+    private:
+        static constexpr std::uint64_t RotateLeft(std::uint64_t value, int shift)
+        {
+            return (value << shift) | (value >> (64 - shift));
+        }
+
+        constexpr void Jump(const std::uint64_t (&polynomial)[4])
+        {
+            std::uint64_t result[4] = {};
+            for(const std::uint64_t word : polynomial)
+            {
+                for(int bit = 0; bit < 64; bit++)
+                {
+                    if(word & (1ull << bit))
+                    {
+                        for(int i = 0; i < 4; i++) result[i] ^= state[i];
+                    }
+                    (*this)();
+                }
+            }
+            for(int i = 0; i < 4; i++) state[i] = result[i];
+        }
+
+        std::uint64_t state[4];
+    };
+
+    class Pcg32
+    {
+    public:
+        typedef std::uint32_t result_type;
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        constexpr Pcg32() : Pcg32(0) {}
+        constexpr explicit Pcg32(std::uint64_t seed, std::uint64_t sequence = DefaultSequence) : state(0), increment(0)
+        {
+            Seed(seed, sequence);
+        }
+
+        constexpr void Seed(std::uint64_t seed, std::uint64_t sequence = DefaultSequence)
+        {
+            state = 0;
+            increment = (sequence << 1) | 1;
+            (*this)();
+            state += seed;
+            (*this)();
+        }
+
+        constexpr result_type operator()()
+        {
+            const std::uint64_t previous = state;
+            state = previous * Multiplier + increment;
+
+            const auto shifted = static_cast<std::uint32_t>(((previous >> 18) ^ previous) >> 27);
+            const auto rotation = static_cast<std::uint32_t>(previous >> 59);
+            return (shifted >> rotation) | (shifted << ((0u - rotation) & 31));
+        }
+
+        constexpr void Discard(std::uint64_t count)
+        {
+            std::uint64_t currentMultiplier = Multiplier;
+            std::uint64_t currentIncrement = increment;
+            std::uint64_t accumulatedMultiplier = 1;
+            std::uint64_t accumulatedIncrement = 0;
+            while(count > 0)
+            {
+                if(count & 1)
+                {
+                    accumulatedMultiplier *= currentMultiplier;
+                    accumulatedIncrement = accumulatedIncrement * currentMultiplier + currentIncrement;
+                }
+                currentIncrement = (currentMultiplier + 1) * currentIncrement;
+                currentMultiplier *= currentMultiplier;
+                count >>= 1;
+            }
+            state = accumulatedMultiplier * state + accumulatedIncrement;
+        }
+
+        // 2^32 and 2^48 draws ahead; use the sequence argument of Seed for fully independent streams.
+        constexpr void Jump()
+        {
+            Discard(1ull << 32);
+        }
+        constexpr void LongJump()
+        {
+            Discard(1ull << 48);
+        }
+
+    private:
+        static constexpr std::uint64_t Multiplier = 6364136223846793005ull;
+        static constexpr std::uint64_t DefaultSequence = 0xDA3E39CB94B95BDBull;
+
+        std::uint64_t state;
+        std::uint64_t increment;
+    };
+
+    // Counter-based Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3"). Word i of a stream
+    // is a pure function of (seed, stream, i), so any position can be generated directly and in any order.
+    class Philox4x32
+    {
+    public:
+        typedef std::uint32_t result_type;
+        typedef std::array<std::uint32_t, 4> Block;
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        constexpr Philox4x32() : Philox4x32(0) {}
+        constexpr explicit Philox4x32(std::uint64_t seed, std::uint64_t stream = 0) : key(0), stream(0), position(0), block{}
+        {
+            Seed(seed, stream);
+        }
+
+        constexpr void Seed(std::uint64_t seed, std::uint64_t newStream = 0)
+        {
+            key = seed;
+            stream = newStream;
+            position = 0;
+        }
+
+        constexpr result_type operator()()
+        {
+            if((position & 3) == 0) block = Generate(key, stream, position >> 2);
+            return block[position++ & 3];
+        }
+
+        constexpr void Discard(std::uint64_t count)
+        {
+            position += count;
+            if((position & 3) != 0) block = Generate(key, stream, position >> 2);
+        }
+
+        // 2^32 and 2^48 draws ahead; use the stream argument of Seed for fully independent streams.
+        constexpr void Jump()
+        {
+            Discard(1ull << 32);
+        }
+        constexpr void LongJump()
+        {
+            Discard(1ull << 48);
+        }
+
+        // The four words at positions 4 * index to 4 * index + 3 of the stream.
+        static constexpr Block Generate(std::uint64_t seed, std::uint64_t stream, std::uint64_t index)
+        {
+            Block counter = {static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32),
+                static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)};
+            std::uint32_t key0 = static_cast<std::uint32_t>(seed);
+            std::uint32_t key1 = static_cast<std::uint32_t>(seed >> 32);
+            for(int round = 0; round < Rounds; round++)
+            {
+                const std::uint64_t product0 = static_cast<std::uint64_t>(Multiplier0) * counter[0];
+                const std::uint64_t product1 = static_cast<std::uint64_t>(Multiplier1) * counter[2];
+                counter = {static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key0, static_cast<std::uint32_t>(product1),
+                    static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key1, static_cast<std::uint32_t>(product0)};
+                key0 += KeyIncrement0;
+                key1 += KeyIncrement1;
+            }
+            return counter;
+        }
+
+        static constexpr result_type Get(std::uint64_t seed, std::uint64_t stream, std::uint64_t position)
+        {
+            return Generate(seed, stream, position >> 2)[position & 3];
+        }
+
+        static constexpr int Rounds = 10;
+        static constexpr std::uint32_t Multiplier0 = 0xD2511F53u;
+        static constexpr std::uint32_t Multiplier1 = 0xCD9E8D57u;
+        static constexpr std::uint32_t KeyIncrement0 = 0x9E3779B9u;
+        static constexpr std::uint32_t KeyIncrement1 = 0xBB67AE85u;
+
+    private:
+        std::uint64_t key;
+        std::uint64_t stream;
+        std::uint64_t position;
+        Block block;
+    };
+
+    typedef Xoshiro256StarStar DefaultRandomEngine;
+}
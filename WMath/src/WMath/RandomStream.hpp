@@ -0,0 +1,242 @@
+﻿#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <span>
+
+#include "WMath/RandomEngines.hpp"
+#include "WMath/Simd.hpp"
+#include "WMath/Vector2.hpp"
+#include "WMath/Vector3.hpp"
+
+namespace WMath
+{
+    template<typename Engine>
+    class BasicRandomStream
+    {
+    public:
+        typedef Engine Generator;
+        typedef unsigned long long SeedType;
+
+        BasicRandomStream() : BasicRandomStream(0) {}
+        explicit BasicRandomStream(SeedType seed) : generator(), seed(seed)
+        {
+            Seed(seed);
+        }
+
+        void Seed(SeedType newSeed)
+        {
+            seed = newSeed;
+            hasSpareBits = false;
+            if constexpr(requires { generator.Seed(newSeed); }) generator.Seed(newSeed);
+            else generator.seed(static_cast<typename Engine::result_type>(newSeed));
+        }
+
+        SeedType GetSeed() const
+        {
+            return seed;
+        }
+
+        Generator& GetGenerator()
+        {
+            return generator;
+        }
+
+        void Jump() requires requires(Engine& engine) { engine.Jump(); }
+        {
+            generator.Jump();
+        }
+
+        void LongJump() requires requires(Engine& engine) { engine.LongJump(); }
+        {
+            generator.LongJump();
+        }
+
+        // 64-bit engines hand out the high half of each word and keep the low half for the next call, so a run of
+        // NextUInt32 calls yields the same values as FillBits over the same state. NextUInt64 always takes a fresh word.
+        std::uint32_t NextUInt32()
+        {
+            if constexpr(sizeof(typename Engine::result_type) >= 8)
+            {
+                if(hasSpareBits)
+                {
+                    hasSpareBits = false;
+                    return spareBits;
+                }
+                const std::uint64_t word = static_cast<std::uint64_t>(generator());
+                spareBits = static_cast<std::uint32_t>(word);
+                hasSpareBits = true;
+                return static_cast<std::uint32_t>(word >> 32);
+            }
+            else return static_cast<std::uint32_t>(generator());
+        }
+
+        std::uint64_t NextUInt64()
+        {
+            if constexpr(sizeof(typename Engine::result_type) >= 8) return static_cast<std::uint64_t>(generator());
+            else
+            {
+                const auto high = static_cast<std::uint64_t>(static_cast<std::uint32_t>(generator()));
+                return high << 32 | static_cast<std::uint32_t>(generator());
+            }
+        }
+
+        int GetValue(int min, int max)
+        {
+            return BoundedInt(NextUInt32(), min, max);
+        }
+
+        float GetValue(float min, float max)
+        {
+            return min + UnitFloat(NextUInt32()) * (max - min);
+        }
+
+        template<typename T>
+        T GetValue(T min, T max)
+        {
+            std::uniform_real_distribution<T> distribution(min, max);
+            return distribution(generator);
+        }
+
+        Vector2 GetVector2(float min, float max)
+        {
+            return {GetValue(min, max), GetValue(min, max)};
+        }
+
+        Vector3 GetVector3(float min, float max)
+        {
+            return {GetValue(min, max), GetValue(min, max), GetValue(min, max)};
+        }
+
+        void FillBits(std::span<std::uint32_t> out)
+        {
+            std::size_t i = 0;
+            if constexpr(sizeof(typename Engine::result_type) >= 8)
+            {
+                if(hasSpareBits && !out.empty()) out[i++] = NextUInt32();
+                for(; i + 2 <= out.size(); i += 2)
+                {
+                    const std::uint64_t word = static_cast<std::uint64_t>(generator());
+                    out[i] = static_cast<std::uint32_t>(word >> 32);
+                    out[i + 1] = static_cast<std::uint32_t>(word);
+                }
+            }
+            for(; i < out.size(); i++) out[i] = NextUInt32();
+        }
+
+        void FillUniform(std::span<float> out, float min, float max)
+        {
+            std::uint32_t bits[ChunkSize];
+            for(std::size_t offset = 0; offset < out.size(); offset += ChunkSize)
+            {
+                const std::size_t count = out.size() - offset < ChunkSize ? out.size() - offset : ChunkSize;
+                FillBits({bits, count});
+                BitsToFloats(bits, out.data() + offset, count, min, max);
+            }
+        }
+
+        void FillUniform(std::span<int> out, int min, int max)
+        {
+            std::uint32_t bits[ChunkSize];
+            const std::uint32_t range = static_cast<std::uint32_t>(max) - static_cast<std::uint32_t>(min) + 1;
+            for(std::size_t offset = 0; offset < out.size(); offset += ChunkSize)
+            {
+                const std::size_t count = out.size() - offset < ChunkSize ? out.size() - offset : ChunkSize;
+                FillBits({bits, count});
+                int* destination = out.data() + offset;
+                if(range == 0)
+                {
+                    std::memcpy(destination, bits, count * sizeof(std::uint32_t));
+                    continue;
+                }
+                for(std::size_t i = 0; i < count; i++)
+                {
+                    std::uint64_t product = static_cast<std::uint64_t>(bits[i]) * range;
+                    if(static_cast<std::uint32_t>(product) < range) product = RejectLemire(product, range);
+                    destination[i] = static_cast<int>(static_cast<std::uint32_t>(min) + static_cast<std::uint32_t>(product >> 32));
+                }
+            }
+        }
+
+        void FillVector2(std::span<Vector2> out, float min, float max)
+        {
+            static_assert(sizeof(Vector2) == 2 * sizeof(float));
+            FillUniform({reinterpret_cast<float*>(out.data()), out.size() * 2}, min, max);
+        }
+
+        void FillVector3(std::span<Vector3> out, float min, float max)
+        {
+            static_assert(sizeof(Vector3) == 3 * sizeof(float));
+            FillUniform({reinterpret_cast<float*>(out.data()), out.size() * 3}, min, max);
+        }
+
+        // Uses the top 23 bits as a mantissa in [1, 2), then shifts to [0, 1).
+        static float UnitFloat(std::uint32_t bits)
+        {
+            return std::bit_cast<float>(bits >> 9 | 0x3F800000u) - 1.0f;
+        }
+
+    private:
+        static constexpr std::size_t ChunkSize = 256;
+
+        // Lemire's nearly divisionless bounded integers; the fast path has no division at all.
+        int BoundedInt(std::uint32_t bits, int min, int max)
+        {
+            const std::uint32_t range = static_cast<std::uint32_t>(max) - static_cast<std::uint32_t>(min) + 1;
+            if(range == 0) return static_cast<int>(bits);
+
+            std::uint64_t product = static_cast<std::uint64_t>(bits) * range;
+            if(static_cast<std::uint32_t>(product) < range) product = RejectLemire(product, range);
+            return static_cast<int>(static_cast<std::uint32_t>(min) + static_cast<std::uint32_t>(product >> 32));
+        }
+
+        std::uint64_t RejectLemire(std::uint64_t product, std::uint32_t range)
+        {
+            const std::uint32_t threshold = (0u - range) % range;
+            while(static_cast<std::uint32_t>(product) < threshold)
+            {
+                product = static_cast<std::uint64_t>(NextUInt32()) * range;
+            }
+            return product;
+        }
+
+        static void BitsToFloats(const std::uint32_t* bits, float* out, std::size_t count, float min, float max)
+        {
+            const float scale = max - min;
+            std::size_t i = 0;
+#if defined(WMATH_AVX2)
+            const __m256i exponent = _mm256_set1_epi32(0x3F800000);
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 min8 = _mm256_set1_ps(min);
+            const __m256 scale8 = _mm256_set1_ps(scale);
+            for(; i + 8 <= count; i += 8)
+            {
+                const __m256i mantissa = _mm256_srli_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bits + i)), 9);
+                const __m256 unit = _mm256_sub_ps(_mm256_castsi256_ps(_mm256_or_si256(mantissa, exponent)), one);
+                _mm256_storeu_ps(out + i, _mm256_add_ps(min8, _mm256_mul_ps(unit, scale8)));
+            }
+#elif defined(WMATH_SSE2)
+            const __m128i exponent = _mm_set1_epi32(0x3F800000);
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 min4 = _mm_set1_ps(min);
+            const __m128 scale4 = _mm_set1_ps(scale);
+            for(; i + 4 <= count; i += 4)
+            {
+                const __m128i mantissa = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bits + i)), 9);
+                const __m128 unit = _mm_sub_ps(_mm_castsi128_ps(_mm_or_si128(mantissa, exponent)), one);
+                _mm_storeu_ps(out + i, _mm_add_ps(min4, _mm_mul_ps(unit, scale4)));
+            }
+#endif
+            for(; i < count; i++) out[i] = min + UnitFloat(bits[i]) * scale;
+        }
+
+        Generator generator;
+        SeedType seed;
+        std::uint32_t spareBits = 0;
+        bool hasSpareBits = false;
+    };
+
+    typedef BasicRandomStream<DefaultRandomEngine> RandomStream;
+}
@@ -0,0 +1,21 @@
+﻿#pragma once
+
+#include "WMath/Vector3.hpp"
+
+namespace WMath
+{
+    // Half-line from origin along a unit direction; every Raycast reports distances along it in world units.
+    struct Ray
+    {
+        Vector3 origin;
+        Vector3 direction;
+
+        constexpr Ray() : origin(), direction(Vector3::Forward()) {}
+        Ray(const Vector3& origin, const Vector3& direction) : origin(origin), direction(direction.Normalized()) {}
+
+        constexpr Vector3 GetPoint(float distance) const
+        {
+            return origin + direction * distance;
+        }
+    };
+}
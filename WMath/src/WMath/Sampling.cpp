@@ -0,0 +1,50 @@
+﻿#include "Sampling.hpp"
+
+#include <cassert>
+#include <cmath>
+
+bool WMath::Sampling::AliasTable::Build(std::span<const float> weights)
+{
+    Clear();
+    assert(weights.size() <= 0xFFFFFFFFu);
+
+    double total = 0.0;
+    for(const float weight : weights)
+    {
+        if(weight > 0.0f) total += weight;
+    }
+    if(!(total > 0.0) || !std::isfinite(total)) return false;
+
+    // Columns start with their weight scaled so the average is 1, then every underfull column is topped up from an
+    // overfull one, which becomes its alias.
+    const std::size_t count = weights.size();
+    std::vector<double> scaled(count);
+    std::vector<std::uint32_t> small;
+    std::vector<std::uint32_t> large;
+    for(std::size_t i = 0; i < count; i++)
+    {
+        scaled[i] = weights[i] > 0.0f ? weights[i] * static_cast<double>(count) / total : 0.0;
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+    }
+
+    entries.resize(count);
+    while(!small.empty() && !large.empty())
+    {
+        const std::uint32_t lower = small.back();
+        const std::uint32_t upper = large.back();
+        small.pop_back();
+
+        entries[lower] = {static_cast<std::uint32_t>(std::ldexp(scaled[lower], 32)), upper};
+        scaled[upper] -= 1.0 - scaled[lower];
+        if(scaled[upper] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(upper);
+        }
+    }
+
+    // Whatever is left is full up to rounding error.
+    for(const std::uint32_t i : small) entries[i] = {0xFFFFFFFFu, i};
+    for(const std::uint32_t i : large) entries[i] = {0xFFFFFFFFu, i};
+    return true;
+}
@@ -0,0 +1,391 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "WMath/FastMath.hpp"
+#include "WMath/Simd.hpp"
+#include "WMath/Vector2.hpp"
+#include "WMath/Vector3.hpp"
+
+// Geometric and statistical distributions over a BasicRandomStream, e.g. Sampling::OnUnitSphere(Random::GetStream()).
+// Every distribution has a Fill variant that draws its uniforms a chunk at a time and transforms them on SIMD lanes.
+namespace WMath::Sampling::Detail
+{
+    constexpr std::size_t ChunkSize = 256;
+    constexpr float TwoPI = 2.0f * PI;
+
+    template<typename L>
+    void UnitCircle(typename L::Float uniform, typename L::Float& x, typename L::Float& y)
+    {
+        // Centering the angle on zero keeps it inside the most accurate range of SinCos.
+        Fast::Detail::SinCos<L>(L::Mul(L::Sub(uniform, L::Set(0.5f)), L::Set(TwoPI)), y, x);
+    }
+
+    template<typename L>
+    typename L::Float SafeSqrt(typename L::Float value)
+    {
+        return Fast::Detail::Sqrt<L>(L::Max(value, L::Set(0.0f)));
+    }
+
+    // -ln(1 - u) for u in [0, 1), which is finite and non-negative.
+    template<typename L>
+    typename L::Float NegativeLog(typename L::Float uniform)
+    {
+        return L::Sub(L::Set(0.0f), Fast::Detail::Ln<L>(L::Sub(L::Set(1.0f), uniform)));
+    }
+
+    // Each kernel maps Uniforms lanes of uniform [0, 1) values to Outputs lanes of packed output floats.
+    struct InsideUnitCircleKernel
+    {
+        static constexpr int Uniforms = 2;
+        static constexpr int Outputs = 2;
+
+        template<typename L>
+        void Apply(const typename L::Float* uniforms, typename L::Float* out) const
+        {
+            const typename L::Float radius = SafeSqrt<L>(uniforms[0]);
+            UnitCircle<L>(uniforms[1], out[0], out[1]);
+            out[0] = L::Mul(out[0], radius);
+            out[1] = L::Mul(out[1], radius);
+        }
+    };
+
+    struct OnUnitCircleKernel
+    {
+        static constexpr int Uniforms = 1;
+        static constexpr int Outputs = 2;
+
+        template<typename L>
+        void Apply(const typename L::Float* uniforms, typename L::Float* out) const
+        {
+            UnitCircle<L>(uniforms[0], out[0], out[1]);
+        }
+    };
+
+    // Uniform z with a uniform angle is uniform on the sphere (Archimedes' hat-box theorem).
+    struct OnUnitSphereKernel
+    {
+        static constexpr int Uniforms = 2;
+        static constexpr int Outputs = 3;
+
+        template<typename L>
+        void Apply(const typename L::Float* uniforms, typename L::Float* out) const
+        {
+            out[2] = L::Sub(L::Set(1.0f), L::Mul(L::Set(2.0f), uniforms[0]));
+            const typename L::Float radius = SafeSqrt<L>(L::Sub(L::Set(1.0f), L::Mul(out[2], out[2])));
+            UnitCircle<L>(uniforms[1], out[0], out[1]);
+            out[0] = L::Mul(out[0], radius);
+            out[1] = L::Mul(out[1], radius);
+        }
+    };
+
+    struct InsideUnitSphereKernel
+    {
+        static constexpr int Uniforms = 3;
+        static constexpr int Outputs = 3;
+
+        template<typename L>
+        void Apply(const typename L::Float* uniforms, typename L::Float* out) const
+        {
+            OnUnitSphereKernel().Apply<L>(uniforms, out);
+            // The cube root of a uniform radius keeps the density uniform in volume; Exp clamps ln(0) to a zero radius.
+            const typename L::Float radius = Fast::Detail::Exp<L>(L::Mul(Fast::Detail::Ln<L>(uniforms[2]), L::Set(1.0f / 3.0f)));
+            for(int i = 0; i < 3; i++) out[i] = L::Mul(out[i], radius);
+        }
+    };
+
+    // Malley's method: a uniform point in the disc projected up onto the hemisphere around +Z.
+    struct CosineHemisphereKernel
+    {
+        static constexpr int Uniforms = 2;
+        static constexpr int Outputs = 3;
+
+        template<typename L>
+        void Apply(const typename L::Float* uniforms, typename L::Float* out) const
+        {
+            InsideUnitCircleKernel().Apply<L>(uniforms, out);
+            out[2] = SafeSqrt<L>(L::Sub(L::Set(1.0f), uniforms[0]));
+        }
+    };
+
+    // Box-Muller, producing two independent values per pair of uniforms.
+    struct NormalKernel
+    {
+        static constexpr int Uniforms = 2;
+        static constexpr int Outputs = 2;
+
+        float mean;
+        float standardDeviation;
+
+        template<typename L>
+        void Apply(const typename L::Float* uniforms, typename L::Float* out) const
+        {
+            const typename L::Float radius = L::Mul(SafeSqrt<L>(L::Mul(L::Set(2.0f), NegativeLog<L>(uniforms[0]))), L::Set(standardDeviation));
+            UnitCircle<L>(uniforms[1], out[0], out[1]);
+            out[0] = L::Add(L::Set(mean), L::Mul(out[0], radius));
+            out[1] = L::Add(L::Set(mean), L::Mul(out[1], radius));
+        }
+    };
+
+    struct ExponentialKernel
+    {
+        static constexpr int Uniforms = 1;
+        static constexpr int Outputs = 1;
+
+        float rate;
+
+        template<typename L>
+        void Apply(const typename L::Float* uniforms, typename L::Float* out) const
+        {
+            out[0] = L::Div(NegativeLog<L>(uniforms[0]), L::Set(rate));
+        }
+    };
+
+    template<typename Kernel, typename Stream>
+    void Sample(Stream& stream, const Kernel& kernel, float* out)
+    {
+        float uniforms[Kernel::Uniforms];
+        for(int i = 0; i < Kernel::Uniforms; i++) uniforms[i] = stream.GetValue(0.0f, 1.0f);
+        kernel.template Apply<Simd::ScalarLanes>(uniforms, out);
+    }
+
+    // Writes count elements of Kernel::Outputs packed floats to out.
+    template<typename Kernel, typename Stream>
+    void Fill(Stream& stream, const Kernel& kernel, float* out, std::size_t count)
+    {
+        typedef Simd::NativeLanes Lanes;
+        static_assert(ChunkSize % Lanes::Width == 0);
+
+        float uniforms[Kernel::Uniforms][ChunkSize];
+        for(std::size_t offset = 0; offset < count; offset += ChunkSize)
+        {
+            const std::size_t chunk = count - offset < ChunkSize ? count - offset : ChunkSize;
+            const std::size_t padded = (chunk + Lanes::Width - 1) / Lanes::Width * Lanes::Width;
+            for(int i = 0; i < Kernel::Uniforms; i++)
+            {
+                stream.FillUniform({uniforms[i], chunk}, 0.0f, 1.0f);
+                for(std::size_t j = chunk; j < padded; j++) uniforms[i][j] = 0.0f;
+            }
+
+            for(std::size_t j = 0; j < padded; j += Lanes::Width)
+            {
+                Lanes::Float input[Kernel::Uniforms];
+                Lanes::Float output[Kernel::Outputs];
+                for(int i = 0; i < Kernel::Uniforms; i++) input[i] = Lanes::Load(uniforms[i] + j);
+                kernel.template Apply<Lanes>(input, output);
+
+                float lanes[Kernel::Outputs][Lanes::Width];
+                for(int i = 0; i < Kernel::Outputs; i++) Lanes::Store(lanes[i], output[i]);
+                const std::size_t laneCount = chunk - j < Lanes::Width ? chunk - j : Lanes::Width;
+                float* destination = out + (offset + j) * Kernel::Outputs;
+                for(std::size_t lane = 0; lane < laneCount; lane++)
+                {
+                    for(int i = 0; i < Kernel::Outputs; i++) destination[lane * Kernel::Outputs + i] = lanes[i][lane];
+                }
+            }
+        }
+    }
+
+    // Duff et al., "Building an Orthonormal Basis, Revisited".
+    inline Vector3 ToBasis(const Vector3& direction, const Vector3& normal)
+    {
+        const float sign = normal.z >= 0.0f ? 1.0f : -1.0f;
+        const float a = -1.0f / (sign + normal.z);
+        const float b = normal.x * normal.y * a;
+        const Vector3 tangent(1.0f + sign * normal.x * normal.x * a, sign * b, -sign * normal.x);
+        const Vector3 bitangent(b, sign + normal.y * normal.y * a, -normal.y);
+        return tangent * direction.x + bitangent * direction.y + normal * direction.z;
+    }
+}
+
+namespace WMath::Sampling
+{
+    static_assert(sizeof(Vector2) == 2 * sizeof(float) && sizeof(Vector3) == 3 * sizeof(float));
+
+    template<typename Stream>
+    Vector2 InsideUnitCircle(Stream& stream)
+    {
+        Vector2 result;
+        Detail::Sample(stream, Detail::InsideUnitCircleKernel(), &result.x);
+        return result;
+    }
+
+    template<typename Stream>
+    Vector2 OnUnitCircle(Stream& stream)
+    {
+        Vector2 result;
+        Detail::Sample(stream, Detail::OnUnitCircleKernel(), &result.x);
+        return result;
+    }
+
+    template<typename Stream>
+    Vector3 InsideUnitSphere(Stream& stream)
+    {
+        Vector3 result;
+        Detail::Sample(stream, Detail::InsideUnitSphereKernel(), &result.x);
+        return result;
+    }
+
+    template<typename Stream>
+    Vector3 OnUnitSphere(Stream& stream)
+    {
+        Vector3 result;
+        Detail::Sample(stream, Detail::OnUnitSphereKernel(), &result.x);
+        return result;
+    }
+
+    // Unit directions on the hemisphere around normal (+Z by default) with density proportional to the cosine of
+    // the angle to it. normal must be unit length.
+    template<typename Stream>
+    Vector3 CosineHemisphere(Stream& stream)
+    {
+        Vector3 result;
+        Detail::Sample(stream, Detail::CosineHemisphereKernel(), &result.x);
+        return result;
+    }
+
+    template<typename Stream>
+    Vector3 CosineHemisphere(Stream& stream, const Vector3& normal)
+    {
+        return Detail::ToBasis(CosineHemisphere(stream), normal);
+    }
+
+    template<typename Stream>
+    float Normal(Stream& stream, float mean = 0.0f, float standardDeviation = 1.0f)
+    {
+        float result[2];
+        Detail::Sample(stream, Detail::NormalKernel{mean, standardDeviation}, result);
+        return result[0];
+    }
+
+    // Waiting times with the given mean rate, i.e. a mean of 1 / rate.
+    template<typename Stream>
+    float Exponential(Stream& stream, float rate = 1.0f)
+    {
+        float result;
+        Detail::Sample(stream, Detail::ExponentialKernel{rate}, &result);
+        return result;
+    }
+
+    template<typename Stream>
+    void FillInsideUnitCircle(Stream& stream, std::span<Vector2> out)
+    {
+        Detail::Fill(stream, Detail::InsideUnitCircleKernel(), reinterpret_cast<float*>(out.data()), out.size());
+    }
+
+    template<typename Stream>
+    void FillOnUnitCircle(Stream& stream, std::span<Vector2> out)
+    {
+        Detail::Fill(stream, Detail::OnUnitCircleKernel(), reinterpret_cast<float*>(out.data()), out.size());
+    }
+
+    template<typename Stream>
+    void FillInsideUnitSphere(Stream& stream, std::span<Vector3> out)
+    {
+        Detail::Fill(stream, Detail::InsideUnitSphereKernel(), reinterpret_cast<float*>(out.data()), out.size());
+    }
+
+    template<typename Stream>
+    void FillOnUnitSphere(Stream& stream, std::span<Vector3> out)
+    {
+        Detail::Fill(stream, Detail::OnUnitSphereKernel(), reinterpret_cast<float*>(out.data()), out.size());
+    }
+
+    template<typename Stream>
+    void FillCosineHemisphere(Stream& stream, std::span<Vector3> out)
+    {
+        Detail::Fill(stream, Detail::CosineHemisphereKernel(), reinterpret_cast<float*>(out.data()), out.size());
+    }
+
+    template<typename Stream>
+    void FillCosineHemisphere(Stream& stream, const Vector3& normal, std::span<Vector3> out)
+    {
+        FillCosineHemisphere(stream, out);
+        for(Vector3& direction : out) direction = Detail::ToBasis(direction, normal);
+    }
+
+    template<typename Stream>
+    void FillNormal(Stream& stream, std::span<float> out, float mean = 0.0f, float standardDeviation = 1.0f)
+    {
+        const Detail::NormalKernel kernel{mean, standardDeviation};
+        Detail::Fill(stream, kernel, out.data(), out.size() / 2);
+        if(out.size() % 2 != 0) out.back() = Normal(stream, mean, standardDeviation);
+    }
+
+    template<typename Stream>
+    void FillExponential(Stream& stream, std::span<float> out, float rate = 1.0f)
+    {
+        Detail::Fill(stream, Detail::ExponentialKernel{rate}, out.data(), out.size());
+    }
+
+    // Walker's alias method with Vose's construction: O(n) to build, then O(1) per weighted choice from a single
+    // 64-bit draw. Negative and NaN weights count as zero.
+    class AliasTable
+    {
+    public:
+        AliasTable() = default;
+        explicit AliasTable(std::span<const float> weights)
+        {
+            Build(weights);
+        }
+
+        // Returns false, leaving the table empty, when no weight is positive.
+        bool Build(std::span<const float> weights);
+        void Clear()
+        {
+            entries.clear();
+        }
+
+        std::size_t Size() const
+        {
+            return entries.size();
+        }
+        bool Empty() const
+        {
+            return entries.empty();
+        }
+
+        // The high half picks a column and the low half decides between it and its alias, so the choice is exact to
+        // 2^-32 for any source of 64 random bits.
+        std::uint32_t Sample(std::uint64_t bits) const
+        {
+            const std::uint32_t column = static_cast<std::uint32_t>((bits >> 32) * entries.size() >> 32);
+            const Entry& entry = entries[column];
+            return static_cast<std::uint32_t>(bits) < entry.threshold ? column : entry.alias;
+        }
+
+        template<typename Stream>
+        std::uint32_t Sample(Stream& stream) const
+        {
+            return Sample(stream.NextUInt64());
+        }
+
+        template<typename Stream>
+        void Fill(Stream& stream, std::span<std::uint32_t> out) const
+        {
+            std::uint32_t bits[2 * Detail::ChunkSize];
+            for(std::size_t offset = 0; offset < out.size(); offset += Detail::ChunkSize)
+            {
+                const std::size_t count = out.size() - offset < Detail::ChunkSize ? out.size() - offset : Detail::ChunkSize;
+                stream.FillBits({bits, 2 * count});
+                for(std::size_t i = 0; i < count; i++)
+                {
+                    out[offset + i] = Sample(static_cast<std::uint64_t>(bits[2 * i]) << 32 | bits[2 * i + 1]);
+                }
+            }
+        }
+
+    private:
+        struct Entry
+        {
+            // The column keeps itself when the low 32 bits are below threshold; full columns alias themselves.
+            std::uint32_t threshold;
+            std::uint32_t alias;
+        };
+
+        std::vector<Entry> entries;
+    };
+}
@@ -0,0 +1,312 @@
+﻿#pragma once
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(WMATH_NO_SIMD)
+    #if defined(__AVX512F__)
+        #define WMATH_AVX512 1
+    #endif
+    #if defined(__AVX2__)
+        #define WMATH_AVX2 1
+    #endif
+    #if defined(__AVX__)
+        #define WMATH_AVX 1
+    #endif
+    #if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+        #define WMATH_F16C 1
+    #endif
+    #if defined(__SSE4_1__) || defined(WMATH_AVX)
+        #define WMATH_SSE4_1 1
+    #endif
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define WMATH_SSE2 1
+    #endif
+#endif
+
+#if defined(WMATH_SSE2)
+    #if defined(WMATH_AVX512) && defined(__GNUC__) && !defined(__clang__)
+        // GCC 12 reports its own _mm512_undefined_* placeholders as uninitialized once they are inlined.
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wuninitialized"
+        #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+        #include <immintrin.h>
+        #pragma GCC diagnostic pop
+    #else
+        #include <immintrin.h>
+    #endif
+#endif
+
+namespace WMath::Simd
+{
+    struct ScalarLanes
+    {
+        typedef float Float;
+        typedef std::int32_t Int;
+        typedef bool Mask;
+
+        static constexpr int Width = 1;
+
+        static Float Set(float value) { return value; }
+        static Int SetInt(std::int32_t value) { return value; }
+        static Float Load(const float* source) { return *source; }
+        static Int LoadInt(const std::int32_t* source) { return *source; }
+        static void Store(float* destination, Float value) { *destination = value; }
+        static void StoreInt(std::int32_t* destination, Int value) { *destination = value; }
+
+        static Float Add(Float a, Float b) { return a + b; }
+        static Float Sub(Float a, Float b) { return a - b; }
+        static Float Mul(Float a, Float b) { return a * b; }
+        static Float Div(Float a, Float b) { return a / b; }
+        static Float Min(Float a, Float b) { return b < a ? b : a; }
+        static Float Max(Float a, Float b) { return a < b ? b : a; }
+        static Float Sqrt(Float a) { return std::sqrt(a); }
+        static Float InvSqrtEstimate(Float a)
+        {
+#if defined(WMATH_SSE2)
+            return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(a)));
+#else
+            float estimate = std::bit_cast<float>(0x5F375A86u - (std::bit_cast<std::uint32_t>(a) >> 1));
+            estimate *= 1.5f - 0.5f * a * estimate * estimate;
+            return estimate * (1.5f - 0.5f * a * estimate * estimate);
+#endif
+        }
+        static Float Floor(Float a) { return std::floor(a); }
+        static Float Abs(Float a) { return std::bit_cast<float>(std::bit_cast<std::uint32_t>(a) & 0x7FFFFFFFu); }
+
+        static Int ToInt(Float a) { return static_cast<Int>(a); }
+        static Float ToFloat(Int a) { return static_cast<Float>(a); }
+        static Int AsInt(Float a) { return std::bit_cast<Int>(a); }
+        static Float AsFloat(Int a) { return std::bit_cast<Float>(a); }
+
+        static Int IntAdd(Int a, Int b) { return static_cast<Int>(static_cast<std::uint32_t>(a) + static_cast<std::uint32_t>(b)); }
+        static Int IntSub(Int a, Int b) { return static_cast<Int>(static_cast<std::uint32_t>(a) - static_cast<std::uint32_t>(b)); }
+        static Int IntMul(Int a, Int b) { return static_cast<Int>(static_cast<std::uint32_t>(a) * static_cast<std::uint32_t>(b)); }
+        static Int IntAnd(Int a, Int b) { return a & b; }
+        static Int IntOr(Int a, Int b) { return a | b; }
+        static Int IntXor(Int a, Int b) { return a ^ b; }
+        template<int Shift> static Int IntShiftLeft(Int a) { return static_cast<Int>(static_cast<std::uint32_t>(a) << Shift); }
+        template<int Shift> static Int IntShiftRight(Int a) { return static_cast<Int>(static_cast<std::uint32_t>(a) >> Shift); }
+
+        static Mask Less(Float a, Float b) { return a < b; }
+        static Mask LessEqual(Float a, Float b) { return a <= b; }
+        static Mask Greater(Float a, Float b) { return a > b; }
+        static Mask And(Mask a, Mask b) { return a && b; }
+        static Mask Or(Mask a, Mask b) { return a || b; }
+        static Float Select(Mask mask, Float a, Float b) { return mask ? a : b; }
+        static Int SelectInt(Mask mask, Int a, Int b) { return mask ? a : b; }
+        static bool Any(Mask mask) { return mask; }
+        static int MoveMask(Mask mask) { return mask ? 1 : 0; }
+
+        static Float Gather(const float* table, Int index) { return table[index]; }
+    };
+
+#if defined(WMATH_SSE4_1)
+    struct Sse41Lanes
+    {
+        typedef __m128 Float;
+        typedef __m128i Int;
+        typedef __m128 Mask;
+
+        static constexpr int Width = 4;
+
+        static Float Set(float value) { return _mm_set1_ps(value); }
+        static Int SetInt(std::int32_t value) { return _mm_set1_epi32(value); }
+        static Float Load(const float* source) { return _mm_loadu_ps(source); }
+        static Int LoadInt(const std::int32_t* source) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(source)); }
+        static void Store(float* destination, Float value) { _mm_storeu_ps(destination, value); }
+        static void StoreInt(std::int32_t* destination, Int value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), value); }
+
+        static Float Add(Float a, Float b) { return _mm_add_ps(a, b); }
+        static Float Sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+        static Float Mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+        static Float Div(Float a, Float b) { return _mm_div_ps(a, b); }
+        static Float Min(Float a, Float b) { return _mm_min_ps(a, b); }
+        static Float Max(Float a, Float b) { return _mm_max_ps(a, b); }
+        static Float Sqrt(Float a) { return _mm_sqrt_ps(a); }
+        static Float InvSqrtEstimate(Float a) { return _mm_rsqrt_ps(a); }
+        static Float Floor(Float a) { return _mm_floor_ps(a); }
+        static Float Abs(Float a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+
+        static Int ToInt(Float a) { return _mm_cvttps_epi32(a); }
+        static Float ToFloat(Int a) { return _mm_cvtepi32_ps(a); }
+        static Int AsInt(Float a) { return _mm_castps_si128(a); }
+        static Float AsFloat(Int a) { return _mm_castsi128_ps(a); }
+
+        static Int IntAdd(Int a, Int b) { return _mm_add_epi32(a, b); }
+        static Int IntSub(Int a, Int b) { return _mm_sub_epi32(a, b); }
+        static Int IntMul(Int a, Int b) { return _mm_mullo_epi32(a, b); }
+        static Int IntAnd(Int a, Int b) { return _mm_and_si128(a, b); }
+        static Int IntOr(Int a, Int b) { return _mm_or_si128(a, b); }
+        static Int IntXor(Int a, Int b) { return _mm_xor_si128(a, b); }
+        template<int Shift> static Int IntShiftLeft(Int a) { return _mm_slli_epi32(a, Shift); }
+        template<int Shift> static Int IntShiftRight(Int a) { return _mm_srli_epi32(a, Shift); }
+
+        static Mask Less(Float a, Float b) { return _mm_cmplt_ps(a, b); }
+        static Mask LessEqual(Float a, Float b) { return _mm_cmple_ps(a, b); }
+        static Mask Greater(Float a, Float b) { return _mm_cmpgt_ps(a, b); }
+        static Mask And(Mask a, Mask b) { return _mm_and_ps(a, b); }
+        static Mask Or(Mask a, Mask b) { return _mm_or_ps(a, b); }
+        static Float Select(Mask mask, Float a, Float b) { return _mm_blendv_ps(b, a, mask); }
+        static Int SelectInt(Mask mask, Int a, Int b) { return _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(b), _mm_castsi128_ps(a), mask)); }
+        static bool Any(Mask mask) { return _mm_movemask_ps(mask) != 0; }
+        static int MoveMask(Mask mask) { return _mm_movemask_ps(mask); }
+
+        static Float Gather(const float* table, Int index)
+        {
+            return _mm_setr_ps(table[_mm_cvtsi128_si32(index)], table[_mm_extract_epi32(index, 1)],
+                table[_mm_extract_epi32(index, 2)], table[_mm_extract_epi32(index, 3)]);
+        }
+    };
+#endif
+
+#if defined(WMATH_AVX2)
+    struct Avx2Lanes
+    {
+        typedef __m256 Float;
+        typedef __m256i Int;
+        typedef __m256 Mask;
+
+        static constexpr int Width = 8;
+
+        static Float Set(float value) { return _mm256_set1_ps(value); }
+        static Int SetInt(std::int32_t value) { return _mm256_set1_epi32(value); }
+        static Float Load(const float* source) { return _mm256_loadu_ps(source); }
+        static Int LoadInt(const std::int32_t* source) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)); }
+        static void Store(float* destination, Float value) { _mm256_storeu_ps(destination, value); }
+        static void StoreInt(std::int32_t* destination, Int value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), value); }
+
+        static Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+        static Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+        static Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+        static Float Div(Float a, Float b) { return _mm256_div_ps(a, b); }
+        static Float Min(Float a, Float b) { return _mm256_min_ps(a, b); }
+        static Float Max(Float a, Float b) { return _mm256_max_ps(a, b); }
+        static Float Sqrt(Float a) { return _mm256_sqrt_ps(a); }
+        static Float InvSqrtEstimate(Float a) { return _mm256_rsqrt_ps(a); }
+        static Float Floor(Float a) { return _mm256_floor_ps(a); }
+        static Float Abs(Float a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+
+        static Int ToInt(Float a) { return _mm256_cvttps_epi32(a); }
+        static Float ToFloat(Int a) { return _mm256_cvtepi32_ps(a); }
+        static Int AsInt(Float a) { return _mm256_castps_si256(a); }
+        static Float AsFloat(Int a) { return _mm256_castsi256_ps(a); }
+
+        static Int IntAdd(Int a, Int b) { return _mm256_add_epi32(a, b); }
+        static Int IntSub(Int a, Int b) { return _mm256_sub_epi32(a, b); }
+        static Int IntMul(Int a, Int b) { return _mm256_mullo_epi32(a, b); }
+        static Int IntAnd(Int a, Int b) { return _mm256_and_si256(a, b); }
+        static Int IntOr(Int a, Int b) { return _mm256_or_si256(a, b); }
+        static Int IntXor(Int a, Int b) { return _mm256_xor_si256(a, b); }
+        template<int Shift> static Int IntShiftLeft(Int a) { return _mm256_slli_epi32(a, Shift); }
+        template<int Shift> static Int IntShiftRight(Int a) { return _mm256_srli_epi32(a, Shift); }
+
+        static Mask Less(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static Mask LessEqual(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+        static Mask Greater(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        static Mask And(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+        static Mask Or(Mask a, Mask b) { return _mm256_or_ps(a, b); }
+        static Float Select(Mask mask, Float a, Float b) { return _mm256_blendv_ps(b, a, mask); }
+        static Int SelectInt(Mask mask, Int a, Int b) { return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(b), _mm256_castsi256_ps(a), mask)); }
+        static bool Any(Mask mask) { return _mm256_movemask_ps(mask) != 0; }
+        static int MoveMask(Mask mask) { return _mm256_movemask_ps(mask); }
+
+        static Float Gather(const float* table, Int index) { return _mm256_i32gather_ps(table, index, 4); }
+    };
+#endif
+
+#if defined(WMATH_AVX512)
+    struct Avx512Lanes
+    {
+        typedef __m512 Float;
+        typedef __m512i Int;
+        typedef __mmask16 Mask;
+
+        static constexpr int Width = 16;
+
+        static Float Set(float value) { return _mm512_set1_ps(value); }
+        static Int SetInt(std::int32_t value) { return _mm512_set1_epi32(value); }
+        static Float Load(const float* source) { return _mm512_loadu_ps(source); }
+        static Int LoadInt(const std::int32_t* source) { return _mm512_loadu_si512(source); }
+        static void Store(float* destination, Float value) { _mm512_storeu_ps(destination, value); }
+        static void StoreInt(std::int32_t* destination, Int value) { _mm512_storeu_si512(destination, value); }
+
+        static Float Add(Float a, Float b) { return _mm512_add_ps(a, b); }
+        static Float Sub(Float a, Float b) { return _mm512_sub_ps(a, b); }
+        static Float Mul(Float a, Float b) { return _mm512_mul_ps(a, b); }
+        static Float Div(Float a, Float b) { return _mm512_div_ps(a, b); }
+        static Float Min(Float a, Float b) { return _mm512_min_ps(a, b); }
+        static Float Max(Float a, Float b) { return _mm512_max_ps(a, b); }
+        static Float Sqrt(Float a) { return _mm512_sqrt_ps(a); }
+        static Float InvSqrtEstimate(Float a) { return _mm512_rsqrt14_ps(a); }
+        static Float Floor(Float a) { return _mm512_mask_roundscale_ps(a, 0xFFFF, a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+        static Float Abs(Float a) { return _mm512_abs_ps(a); }
+
+        static Int ToInt(Float a) { return _mm512_cvttps_epi32(a); }
+        static Float ToFloat(Int a) { return _mm512_cvtepi32_ps(a); }
+        static Int AsInt(Float a) { return _mm512_castps_si512(a); }
+        static Float AsFloat(Int a) { return _mm512_castsi512_ps(a); }
+
+        static Int IntAdd(Int a, Int b) { return _mm512_add_epi32(a, b); }
+        static Int IntSub(Int a, Int b) { return _mm512_sub_epi32(a, b); }
+        static Int IntMul(Int a, Int b) { return _mm512_mullo_epi32(a, b); }
+        static Int IntAnd(Int a, Int b) { return _mm512_and_si512(a, b); }
+        static Int IntOr(Int a, Int b) { return _mm512_or_si512(a, b); }
+        static Int IntXor(Int a, Int b) { return _mm512_xor_si512(a, b); }
+        template<int Shift> static Int IntShiftLeft(Int a) { return _mm512_slli_epi32(a, Shift); }
+        template<int Shift> static Int IntShiftRight(Int a) { return _mm512_srli_epi32(a, Shift); }
+
+        static Mask Less(Float a, Float b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+        static Mask LessEqual(Float a, Float b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+        static Mask Greater(Float a, Float b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+        static Mask And(Mask a, Mask b) { return static_cast<Mask>(a & b); }
+        static Mask Or(Mask a, Mask b) { return static_cast<Mask>(a | b); }
+        static Float Select(Mask mask, Float a, Float b) { return _mm512_mask_blend_ps(mask, b, a); }
+        static Int SelectInt(Mask mask, Int a, Int b) { return _mm512_mask_blend_epi32(mask, b, a); }
+        static bool Any(Mask mask) { return mask != 0; }
+        static int MoveMask(Mask mask) { return mask; }
+
+        static Float Gather(const float* table, Int index) { return _mm512_i32gather_ps(index, table, 4); }
+    };
+#endif
+
+#if defined(WMATH_AVX512)
+    typedef Avx512Lanes NativeLanes;
+#elif defined(WMATH_AVX2)
+    typedef Avx2Lanes NativeLanes;
+#elif defined(WMATH_SSE4_1)
+    typedef Sse41Lanes NativeLanes;
+#else
+    typedef ScalarLanes NativeLanes;
+#endif
+
+    // Transposes count packed elements of Components floats, 1 <= count <= Lanes::Width, into one register per
+    // component. Lanes past count repeat the last element, so padding never produces values the real lanes could not.
+    template<typename Lanes, std::size_t Components>
+    void LoadTransposed(const float* in, std::size_t count, typename Lanes::Float (&values)[Components])
+    {
+        if(count == Lanes::Width)
+        {
+            static constexpr std::array<std::int32_t, Lanes::Width> offsets = []
+            {
+                std::array<std::int32_t, Lanes::Width> result = {};
+                for(std::size_t lane = 0; lane < Lanes::Width; lane++) result[lane] = static_cast<std::int32_t>(lane * Components);
+                return result;
+            }();
+            const typename Lanes::Int indices = Lanes::LoadInt(offsets.data());
+            for(std::size_t component = 0; component < Components; component++) values[component] = Lanes::Gather(in + component, indices);
+            return;
+        }
+
+        float transposed[Components][Lanes::Width];
+        for(std::size_t lane = 0; lane < Lanes::Width; lane++)
+        {
+            const float* element = in + (lane < count ? lane : count - 1) * Components;
+            for(std::size_t component = 0; component < Components; component++) transposed[component][lane] = element[component];
+        }
+        for(std::size_t component = 0; component < Components; component++) values[component] = Lanes::Load(transposed[component]);
+    }
+}
@@ -0,0 +1,56 @@
+﻿#pragma once
+
+#include <limits>
+#include "WMath/AABB.hpp"
+#include "WMath/Ray.hpp"
+#include "WMath/Vector3.hpp"
+
+namespace WMath
+{
+    struct Sphere
+    {
+        Vector3 center;
+        float radius;
+
+        constexpr Sphere() : center(), radius(0) {}
+        constexpr Sphere(const Vector3& center, float radius) : center(center), radius(radius) {}
+
+        constexpr AABB GetBounds() const
+        {
+            return AABB::FromCenter(center, Vector3(radius));
+        }
+
+        constexpr bool Contains(const Vector3& point) const
+        {
+            return (point - center).MagnitudeSquared() <= radius * radius;
+        }
+        constexpr bool Intersects(const Sphere& other) const
+        {
+            const float radii = radius + other.radius;
+            return (other.center - center).MagnitudeSquared() <= radii * radii;
+        }
+        constexpr bool Intersects(const AABB& box) const
+        {
+            return box.DistanceSquared(center) <= radius * radius;
+        }
+
+        // A ray starting inside the sphere hits at distance 0.
+        bool Raycast(const Ray& ray, float& distance, float maxDistance = std::numeric_limits<float>::infinity()) const
+        {
+            const Vector3 offset = ray.origin - center;
+            const float b = Vector3::Dot(offset, ray.direction);
+            const float c = offset.MagnitudeSquared() - radius * radius;
+            const float discriminant = b * b - c;
+            if(discriminant < 0) return false;
+
+            const float root = Sqrt(discriminant);
+            if(-b + root < 0) return false;
+
+            const float enter = Max(-b - root, 0.0f);
+            if(enter > maxDistance) return false;
+
+            distance = enter;
+            return true;
+        }
+    };
+}
@@ -0,0 +1,158 @@
+﻿#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    // Set on pool workers and on a thread while it dispatches, so nested dispatches run inline instead of deadlocking.
+    thread_local bool insideDispatch = false;
+
+    std::uint64_t Pack(std::uint32_t begin, std::uint32_t end)
+    {
+        return static_cast<std::uint64_t>(begin) << 32 | end;
+    }
+
+    std::uint32_t Begin(std::uint64_t chunks)
+    {
+        return static_cast<std::uint32_t>(chunks >> 32);
+    }
+
+    std::uint32_t End(std::uint64_t chunks)
+    {
+        return static_cast<std::uint32_t>(chunks);
+    }
+}
+
+WMath::ThreadPool::ThreadPool(unsigned threadCount)
+{
+    if(threadCount == 0) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    slotCount = threadCount;
+    slots = std::make_unique<Slot[]>(slotCount);
+    workers.reserve(slotCount - 1);
+    for(unsigned slot = 1; slot < slotCount; slot++) workers.emplace_back([this, slot] { Work(slot); });
+}
+
+WMath::ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for(std::thread& worker : workers) worker.join();
+}
+
+WMath::ThreadPool& WMath::ThreadPool::Global()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+void WMath::ThreadPool::Dispatch(std::size_t count, std::size_t grainSize, Task task)
+{
+    if(count == 0) return;
+
+    // Chunk indices are 32-bit, so huge inputs get a coarser grain.
+    constexpr std::size_t MaxChunks = std::numeric_limits<std::uint32_t>::max();
+    grainSize = std::max({grainSize, std::size_t(1), (count + MaxChunks - 1) / MaxChunks});
+    const std::size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+    const Job current = {task, count, grainSize};
+    if(chunkCount == 1 || slotCount == 1 || insideDispatch || !dispatchMutex.try_lock())
+    {
+        for(std::size_t begin = 0; begin < count; begin += grainSize) task.run(task.context, begin, std::min(count, begin + grainSize));
+        return;
+    }
+
+    for(unsigned slot = 0; slot < slotCount; slot++)
+    {
+        const std::uint32_t begin = static_cast<std::uint32_t>(chunkCount * slot / slotCount);
+        const std::uint32_t end = static_cast<std::uint32_t>(chunkCount * (slot + 1) / slotCount);
+        slots[slot].chunks.store(Pack(begin, end), std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &current;
+        generation++;
+    }
+    if(chunkCount >= slotCount) wake.notify_all();
+    else for(std::size_t i = 1; i < chunkCount; i++) wake.notify_one();
+
+    insideDispatch = true;
+    Participate(current, 0);
+    insideDispatch = false;
+
+    // Workers only pick up a job under the mutex, so once it is cleared every worker that saw it is counted in active.
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = nullptr;
+    }
+    for(unsigned busy = active.load(std::memory_order_acquire); busy != 0; busy = active.load(std::memory_order_acquire))
+    {
+        active.wait(busy, std::memory_order_acquire);
+    }
+    dispatchMutex.unlock();
+}
+
+void WMath::ThreadPool::Work(unsigned slot)
+{
+    insideDispatch = true;
+
+    std::uint64_t seen = 0;
+    for(;;)
+    {
+        const Job* current;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || (job != nullptr && generation != seen); });
+            if(stopping) return;
+
+            seen = generation;
+            current = job;
+            active.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Participate(*current, slot);
+        if(active.fetch_sub(1, std::memory_order_release) == 1) active.notify_all();
+    }
+}
+
+void WMath::ThreadPool::Participate(const Job& current, unsigned slot)
+{
+    std::atomic<std::uint64_t>& own = slots[slot].chunks;
+    do
+    {
+        std::uint64_t chunks = own.load(std::memory_order_relaxed);
+        while(Begin(chunks) < End(chunks))
+        {
+            if(!own.compare_exchange_weak(chunks, Pack(Begin(chunks) + 1, End(chunks)), std::memory_order_relaxed)) continue;
+
+            const std::size_t begin = Begin(chunks) * current.grainSize;
+            current.task.run(current.task.context, begin, std::min(current.count, begin + current.grainSize));
+            chunks = own.load(std::memory_order_relaxed);
+        }
+    } while(Steal(slot));
+}
+
+bool WMath::ThreadPool::Steal(unsigned slot)
+{
+    // A chunk is claimed exactly once and never returns to any range, so a range value cannot repeat and the CAS
+    // below is free of ABA problems.
+    for(unsigned offset = 1; offset < slotCount; offset++)
+    {
+        std::atomic<std::uint64_t>& victim = slots[(slot + offset) % slotCount].chunks;
+        std::uint64_t chunks = victim.load(std::memory_order_relaxed);
+        while(Begin(chunks) < End(chunks))
+        {
+            const std::uint32_t middle = End(chunks) - (End(chunks) - Begin(chunks) + 1) / 2;
+            if(victim.compare_exchange_weak(chunks, Pack(Begin(chunks), middle), std::memory_order_relaxed))
+            {
+                slots[slot].chunks.store(Pack(middle, End(chunks)), std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    return false;
+}
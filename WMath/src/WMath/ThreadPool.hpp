@@ -0,0 +1,85 @@
+﻿#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace WMath
+{
+    // Fixed set of worker threads that split index ranges with the dispatching thread. Each participant owns a range
+    // of chunks and takes them from its front; once empty it steals the back half of another participant's range, so
+    // uneven chunks balance out without a shared queue. A dispatch allocates nothing.
+    class ThreadPool
+    {
+    public:
+        // A threadCount of 0 uses one thread per hardware thread, counting the dispatching thread.
+        explicit ThreadPool(unsigned threadCount = 0);
+        ThreadPool(const ThreadPool& other) = delete;
+
+        ~ThreadPool();
+
+        ThreadPool& operator=(const ThreadPool& other) = delete;
+
+        static ThreadPool& Global();
+
+        // Threads working on a dispatch, including the dispatching thread.
+        unsigned Size() const
+        {
+            return slotCount;
+        }
+
+        // Calls function(begin, end) on consecutive ranges of at most grainSize indices that cover [0, count), and
+        // returns once all of them have finished. The function must not throw. Dispatches made from inside a running
+        // function, or while another thread is dispatching on this pool, run on the calling thread.
+        template<typename Function>
+        void For(std::size_t count, std::size_t grainSize, const Function& function)
+        {
+            Dispatch(count, grainSize, {&function, [](const void* context, std::size_t begin, std::size_t end)
+            {
+                (*static_cast<const Function*>(context))(begin, end);
+            }});
+        }
+
+    private:
+        struct Task
+        {
+            const void* context;
+            void (*run)(const void* context, std::size_t begin, std::size_t end);
+        };
+
+        struct Job
+        {
+            Task task;
+            std::size_t count;
+            std::size_t grainSize;
+        };
+
+        // Unclaimed chunks [begin, end) packed as begin << 32 | end, so claiming and stealing are single CASes.
+        struct alignas(64) Slot
+        {
+            std::atomic<std::uint64_t> chunks;
+        };
+
+        unsigned slotCount;
+        std::unique_ptr<Slot[]> slots;
+        std::vector<std::thread> workers;
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        const Job* job = nullptr;
+        std::uint64_t generation = 0;
+        bool stopping = false;
+        std::atomic<unsigned> active = 0;
+        std::mutex dispatchMutex;
+
+        void Dispatch(std::size_t count, std::size_t grainSize, Task task);
+        void Work(unsigned slot);
+        void Participate(const Job& job, unsigned slot);
+        bool Steal(unsigned slot);
+    };
+}
@@ -0,0 +1,79 @@
+﻿#pragma once
+
+#include <limits>
+#include "WMath/AABB.hpp"
+#include "WMath/Ray.hpp"
+#include "WMath/Vector3.hpp"
+
+namespace WMath
+{
+    struct Triangle
+    {
+        Vector3 a;
+        Vector3 b;
+        Vector3 c;
+
+        constexpr Triangle() = default;
+        constexpr Triangle(const Vector3& a, const Vector3& b, const Vector3& c) : a(a), b(b), c(c) {}
+
+        // Unit normal for counter-clockwise winding.
+        Vector3 Normal() const
+        {
+            return Vector3::Cross(b - a, c - a).Normalized();
+        }
+        float Area() const
+        {
+            return Vector3::Cross(b - a, c - a).Magnitude() * 0.5f;
+        }
+        constexpr Vector3 Center() const
+        {
+            return (a + b + c) / 3.0f;
+        }
+        constexpr AABB GetBounds() const
+        {
+            return {Vector3::Min(Vector3::Min(a, b), c), Vector3::Max(Vector3::Max(a, b), c)};
+        }
+
+        // Weights (u, v, w) with point == a * u + b * v + c * w for a point in the triangle's plane.
+        constexpr Vector3 Barycentric(const Vector3& point) const
+        {
+            const Vector3 edge1 = b - a;
+            const Vector3 edge2 = c - a;
+            const Vector3 offset = point - a;
+            const float d11 = Vector3::Dot(edge1, edge1);
+            const float d12 = Vector3::Dot(edge1, edge2);
+            const float d22 = Vector3::Dot(edge2, edge2);
+            const float d1 = Vector3::Dot(offset, edge1);
+            const float d2 = Vector3::Dot(offset, edge2);
+            const float inverseDenominator = 1.0f / (d11 * d22 - d12 * d12);
+            const float v = (d22 * d1 - d12 * d2) * inverseDenominator;
+            const float w = (d11 * d2 - d12 * d1) * inverseDenominator;
+            return {1.0f - v - w, v, w};
+        }
+
+        // Moller-Trumbore; hits both faces.
+        bool Raycast(const Ray& ray, float& distance, float maxDistance = std::numeric_limits<float>::infinity()) const
+        {
+            const Vector3 edge1 = b - a;
+            const Vector3 edge2 = c - a;
+            const Vector3 p = Vector3::Cross(ray.direction, edge2);
+            const float determinant = Vector3::Dot(edge1, p);
+            if(determinant == 0) return false;
+
+            const float inverseDeterminant = 1.0f / determinant;
+            const Vector3 offset = ray.origin - a;
+            const float u = Vector3::Dot(offset, p) * inverseDeterminant;
+            if(u < 0 || u > 1) return false;
+
+            const Vector3 q = Vector3::Cross(offset, edge1);
+            const float v = Vector3::Dot(ray.direction, q) * inverseDeterminant;
+            if(v < 0 || u + v > 1) return false;
+
+            const float enter = Vector3::Dot(edge2, q) * inverseDeterminant;
+            if(enter < 0 || enter > maxDistance) return false;
+
+            distance = enter;
+            return true;
+        }
+    };
+}
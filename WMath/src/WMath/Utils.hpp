@@ -1,6 +1,14 @@
 ﻿#pragma once
 
+#include <algorithm>
+#include <bit>
+#include <cfloat>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <type_traits>
+#include "WMath/ConstexprMath.hpp"
 
 namespace WMath
 {
@@ -12,79 +20,233 @@ namespace WMath
     constexpr float Rad2Deg = static_cast<float>(180.0 / 3.14159265358979323846);
     constexpr float Epsilon = FLT_EPSILON;
 
-    float Abs(float number);
-
-    int Abs(int number);
-
-    float Acos(float number);
-
-    float Asin(float number);
-
-    float Atan(float number);
-
-    float Atan2(float y, float x);
-
-    float Ceil(float number);
-
-    int CeilToInt(float number);
-
-    float Clamp(float value, float min, float max);
-
-    float Clamp01(float value);
-
-    float Cos(float number);
-
-    bool Equals(float a, float b, float epsilon = Epsilon);
-
-    float Exp(float number);
-
-    float Floor(float number);
-
-    int FloorToInt(float number);
-
-    float InvLerp(float start, float end, float value);
-
-    float Lerp(float start, float end, float value);
-
-    float Ln(float number);
-
-    float Log(float number, float base);
-
-    float Log10(float number);
+    // Every function here is constexpr. In constant evaluation the non-trivial ones go through WMath::Constexpr, which
+    // agrees with the runtime libm result to within an ulp; at run time they call libm as before.
+
+    // Clears the sign bit like fabsf, so Abs(-0.0f) is +0.0f and NaNs keep their payload.
+    constexpr float Abs(float number)
+    {
+        return std::bit_cast<float>(std::bit_cast<std::uint32_t>(number) & 0x7FFFFFFFu);
+    }
+
+    constexpr int Abs(int number)
+    {
+        return number < 0 ? -number : number;
+    }
+
+    constexpr float Acos(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(Constexpr::Acos(number));
+        return acosf(number);
+    }
+
+    constexpr float Asin(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(Constexpr::Asin(number));
+        return asinf(number);
+    }
+
+    constexpr float Atan(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(Constexpr::Atan(number));
+        return atanf(number);
+    }
+
+    constexpr float Atan2(float y, float x)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(Constexpr::Atan2(y, x));
+        return atan2f(y, x);
+    }
+
+    constexpr float Ceil(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(Constexpr::Ceil(number));
+        return ceilf(number);
+    }
+
+    constexpr int CeilToInt(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<int>(Constexpr::Ceil(number));
+        return static_cast<int>(ceilf(number));
+    }
+
+    constexpr float Clamp(float value, float min, float max)
+    {
+        return value < min ? min : value > max ? max : value;
+    }
+
+    constexpr float Clamp01(float value)
+    {
+        return Clamp(value, 0, 1);
+    }
+
+    constexpr float Cos(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(Constexpr::Cos(number));
+        return cosf(number);
+    }
+
+    constexpr bool Equals(float a, float b, float epsilon = Epsilon)
+    {
+        return Abs(a - b) <= epsilon;
+    }
+
+    constexpr float Exp(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(Constexpr::Exp(number));
+        return expf(number);
+    }
+
+    constexpr float Floor(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(Constexpr::Floor(number));
+        return floorf(number);
+    }
+
+    constexpr int FloorToInt(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<int>(Constexpr::Floor(number));
+        return static_cast<int>(floorf(number));
+    }
+
+    constexpr float InvLerp(float start, float end, float value)
+    {
+        return (value - start) / (end - start);
+    }
+
+    constexpr float InvSqrt(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(1.0 / Constexpr::Sqrt(number));
+        return 1.0f / sqrtf(number);
+    }
+
+    constexpr float Lerp(float start, float end, float value)
+    {
+        return start + (end - start) * value;
+    }
+
+    constexpr float Ln(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(Constexpr::Ln(number));
+        return logf(number);
+    }
+
+    constexpr float Log(float number, float base)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(Constexpr::Ln(number) / Constexpr::Ln(base));
+        return logf(number) / logf(base);
+    }
+
+    constexpr float Log10(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(Constexpr::Ln(number) / 2.302585092994045684);
+        return log10f(number);
+    }
 
     template <typename T>
-    T Max(const T& a, const T& b);
+    constexpr T Max(const T& a, const T& b)
+    {
+        return a > b ? a : b;
+    }
 
     template <typename T>
-    T Max(std::initializer_list<T> numbers);
+    constexpr T Max(std::initializer_list<T> numbers)
+    {
+        return std::max(numbers);
+    }
 
     template <typename T>
-    T Min(const T& a, const T& b);
+    constexpr T Min(const T& a, const T& b)
+    {
+        return a < b ? a : b;
+    }
 
     template <typename T>
-    T Min(std::initializer_list<T> numbers);
-
-    float Sign(float number);
-
-    int Sign(int number);
-
-    float MoveTowards(float current, float target, float maxDelta);
-
-    float Pow(float number, float power);
-
-    float Round(float number);
-
-    int RoundToInt(float number);
-
-    float Sin(float number);
-    
-    float SmoothStep(float start, float end, float value);
-    
-    float Sqrt(float number);
-    
-    float Tan(float number);
-
-    float ToDegrees(float radians);
-    
-    float ToRadians(float degrees);
+    constexpr T Min(std::initializer_list<T> numbers)
+    {
+        return std::min(numbers);
+    }
+
+    constexpr float Sign(float number)
+    {
+        return number > 0.0f ? 1.0f : number < 0.0f ? -1.0f : 0;
+    }
+
+    constexpr int Sign(int number)
+    {
+        return number > 0 ? 1 : number < 0 ? -1 : 0;
+    }
+
+    constexpr float MoveTowards(float current, float target, float maxDelta)
+    {
+        if (Abs(target - current) <= maxDelta) return target;
+
+        return current + Sign(target - current) * maxDelta;
+    }
+
+    constexpr float Pow(float number, float power)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(Constexpr::Pow(number, power));
+        return powf(number, power);
+    }
+
+    constexpr float Round(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(Constexpr::Round(number));
+        return roundf(number);
+    }
+
+    constexpr int RoundToInt(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<int>(Constexpr::Round(number));
+        return static_cast<int>(roundf(number));
+    }
+
+    constexpr float Sin(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(Constexpr::Sin(number));
+        return sinf(number);
+    }
+
+    constexpr void SinCos(float number, float& sin, float& cos)
+    {
+        if(std::is_constant_evaluated())
+        {
+            double sinExact = 0, cosExact = 0;
+            Constexpr::SinCos(number, sinExact, cosExact);
+            sin = static_cast<float>(sinExact);
+            cos = static_cast<float>(cosExact);
+            return;
+        }
+        sin = sinf(number);
+        cos = cosf(number);
+    }
+
+    constexpr float SmoothStep(float start, float end, float value)
+    {
+        const float x = Clamp01((value - start) / (end - start));
+        return x * x * (3 - 2 * x);
+    }
+
+    constexpr float Sqrt(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(Constexpr::Sqrt(number));
+        return sqrtf(number);
+    }
+
+    constexpr float Tan(float number)
+    {
+        if(std::is_constant_evaluated()) return static_cast<float>(Constexpr::Tan(number));
+        return tanf(number);
+    }
+
+    constexpr float ToDegrees(float radians)
+    {
+        return radians * Rad2Deg;
+    }
+
+    constexpr float ToRadians(float degrees)
+    {
+        return degrees * Deg2Rad;
+    }
 }
@@ -0,0 +1,365 @@
+﻿#pragma once
+
+#include <cfloat>
+#include <concepts>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include "WMath/FastMath.hpp"
+
+namespace WMath
+{
+    template<int N, typename T>
+    struct VectorStorage;
+
+    template<typename T>
+    struct VectorStorage<2, T>
+    {
+        T x;
+        T y;
+    };
+
+    template<typename T>
+    struct VectorStorage<3, T>
+    {
+        T x;
+        T y;
+        T z;
+    };
+
+    template<typename T>
+    struct VectorStorage<4, T>
+    {
+        T x;
+        T y;
+        T z;
+        T w;
+    };
+
+    // N-component vector over float, double or std::int32_t. Components live in VectorStorage so that every
+    // specialization keeps the x, y, z, w member names and a packed, standard layout. Length, angle and interpolation
+    // functions are only available for floating-point components.
+    template<int N, typename T>
+    class Vector : public VectorStorage<N, T>
+    {
+        static_assert(N >= 2 && N <= 4, "Vector supports 2 to 4 components");
+        static_assert(std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, std::int32_t>,
+            "Vector supports float, double and std::int32_t components");
+
+        typedef VectorStorage<N, T> Storage;
+
+    public:
+        typedef T ValueType;
+
+        static constexpr int Dimensions = N;
+        static constexpr T DefaultEpsilon = std::is_same_v<T, float> ? static_cast<T>(Epsilon) :
+            std::is_same_v<T, double> ? static_cast<T>(DBL_EPSILON) : T(0);
+
+        static constexpr Vector Zero() { return Vector(0); }
+        static constexpr Vector One() { return Vector(1); }
+
+        static constexpr Vector Up() { return Axis(1, 1); }
+        static constexpr Vector Down() { return Axis(1, -1); }
+        static constexpr Vector Left() { return Axis(0, -1); }
+        static constexpr Vector Right() { return Axis(0, 1); }
+        static constexpr Vector Forward() requires(N >= 3) { return Axis(2, 1); }
+        static constexpr Vector Back() requires(N >= 3) { return Axis(2, -1); }
+
+        constexpr Vector() : Storage{} {}
+        constexpr Vector(T value) requires(N == 2) : Storage{value, value} {}
+        constexpr Vector(T value) requires(N == 3) : Storage{value, value, value} {}
+        constexpr Vector(T value) requires(N == 4) : Storage{value, value, value, value} {}
+        constexpr Vector(T x, T y) requires(N == 2) : Storage{x, y} {}
+        constexpr Vector(T x, T y, T z) requires(N == 3) : Storage{x, y, z} {}
+        constexpr Vector(T x, T y, T z, T w) requires(N == 4) : Storage{x, y, z, w} {}
+        constexpr Vector(const Vector<N - 1, T>& vector, T z = 0) requires(N == 3) : Storage{vector.x, vector.y, z} {}
+        constexpr Vector(const Vector<N - 1, T>& vector, T w = 0) requires(N == 4) : Storage{vector.x, vector.y, vector.z, w} {}
+
+        template<typename U>
+        constexpr explicit Vector(const Vector<N, U>& other)
+            : Vector(Map(other, [](U value) { return static_cast<T>(value); }))
+        {
+        }
+
+        constexpr Vector& operator=(const Vector<N - 1, T>& other) requires(N == 3)
+        {
+            this->x = other.x;
+            this->y = other.y;
+            this->z = 0;
+
+            return *this;
+        }
+
+        constexpr T operator[](int i) const
+        {
+            if(i == 0) return this->x;
+            if(i == 1) return this->y;
+            if constexpr(N >= 3) if(i == 2) return this->z;
+            if constexpr(N >= 4) if(i == 3) return this->w;
+            return 0;
+        }
+
+        constexpr int operator<=>(const Vector& other) const
+        {
+            if(ScalarEquals(MagnitudeSquared(), other.MagnitudeSquared(), DefaultEpsilon)) return 0;
+            return MagnitudeSquared() < other.MagnitudeSquared() ? -1 : 1;
+        }
+        constexpr bool operator==(const Vector& other) const
+        {
+            return Equals(other);
+        }
+        constexpr bool operator!=(const Vector& other) const
+        {
+            return !Equals(other);
+        }
+
+        constexpr Vector operator+(const Vector& other) const
+        {
+            return Map(*this, other, [](T a, T b) { return a + b; });
+        }
+        constexpr Vector& operator+=(const Vector& other)
+        {
+            return *this = *this + other;
+        }
+
+        constexpr Vector operator-(const Vector& other) const
+        {
+            return Map(*this, other, [](T a, T b) { return a - b; });
+        }
+        constexpr Vector& operator-=(const Vector& other)
+        {
+            return *this = *this - other;
+        }
+
+        constexpr Vector operator*(const T scalar) const
+        {
+            return Map(*this, [scalar](T a) { return a * scalar; });
+        }
+        constexpr Vector& operator*=(const T scalar)
+        {
+            return *this = *this * scalar;
+        }
+        constexpr Vector operator*(const Vector& other) const
+        {
+            return Map(*this, other, [](T a, T b) { return a * b; });
+        }
+        constexpr Vector& operator*=(const Vector& other)
+        {
+            return *this = *this * other;
+        }
+
+        constexpr Vector operator/(const T scalar) const
+        {
+            return Map(*this, [scalar](T a) { return a / scalar; });
+        }
+        constexpr Vector& operator/=(const T scalar)
+        {
+            return *this = *this / scalar;
+        }
+        constexpr Vector operator/(const Vector& other) const
+        {
+            return Map(*this, other, [](T a, T b) { return a / b; });
+        }
+        constexpr Vector& operator/=(const Vector& other)
+        {
+            return *this = *this / other;
+        }
+
+        constexpr bool Equals(const Vector& other, T epsilon = DefaultEpsilon) const
+        {
+            bool equal = ScalarEquals(this->x, other.x, epsilon) && ScalarEquals(this->y, other.y, epsilon);
+            if constexpr(N >= 3) equal = equal && ScalarEquals(this->z, other.z, epsilon);
+            if constexpr(N >= 4) equal = equal && ScalarEquals(this->w, other.w, epsilon);
+            return equal;
+        }
+
+        template<Precision P = Precision::Exact>
+        constexpr T Magnitude() const requires std::floating_point<T>
+        {
+            return Sqrt<P>(MagnitudeSquared());
+        }
+        constexpr T Length() const requires std::floating_point<T>
+        {
+            return Magnitude();
+        }
+
+        constexpr T MagnitudeSquared() const
+        {
+            return Dot(*this, *this);
+        }
+        constexpr T LengthSquared() const
+        {
+            return MagnitudeSquared();
+        }
+
+        template<Precision P = Precision::Exact>
+        constexpr Vector Normalized() const requires std::floating_point<T>
+        {
+            if constexpr(P == Precision::Fast) return *this * InvSqrt<P>(MagnitudeSquared());
+
+            return *this / Magnitude();
+        }
+        template<Precision P = Precision::Exact>
+        constexpr void Normalize() requires std::floating_point<T>
+        {
+            *this = Normalized<P>();
+        }
+
+        std::string ToString() const
+        {
+            std::string result = "(" + std::to_string(this->x) + ", " + std::to_string(this->y);
+            if constexpr(N >= 3) result += ", " + std::to_string(this->z);
+            if constexpr(N >= 4) result += ", " + std::to_string(this->w);
+            return result + ")";
+        }
+
+        template<Precision P = Precision::Exact>
+        static constexpr T Angle(const Vector& lhs, const Vector& rhs) requires(N == 2 && std::floating_point<T>)
+        {
+            const T angle = AbsAngle<P>(lhs, rhs);
+            if(Cross(lhs, rhs) < 0) return -angle;
+            return angle;
+        }
+        template<Precision P = Precision::Exact>
+        static constexpr T AbsAngle(const Vector& lhs, const Vector& rhs) requires std::floating_point<T>
+        {
+            const T dot = ClampUnit(Dot(lhs.template Normalized<P>(), rhs.template Normalized<P>()));
+            return Acos<P>(dot) * static_cast<T>(180.0 / 3.14159265358979323846);
+        }
+        static constexpr T Cross(const Vector& lhs, const Vector& rhs) requires(N == 2)
+        {
+            return lhs.x * rhs.y - lhs.y * rhs.x;
+        }
+        static constexpr Vector Cross(const Vector& lhs, const Vector& rhs) requires(N == 3)
+        {
+            return {lhs.y * rhs.z - lhs.z * rhs.y,
+                lhs.z * rhs.x - lhs.x * rhs.z,
+                lhs.x * rhs.y - lhs.y * rhs.x};
+        }
+        template<Precision P = Precision::Exact>
+        static constexpr T Distance(const Vector& lhs, const Vector& rhs) requires std::floating_point<T>
+        {
+            return (lhs - rhs).template Magnitude<P>();
+        }
+        static constexpr T Dot(const Vector& lhs, const Vector& rhs)
+        {
+            T dot = lhs.x * rhs.x + lhs.y * rhs.y;
+            if constexpr(N >= 3) dot += lhs.z * rhs.z;
+            if constexpr(N >= 4) dot += lhs.w * rhs.w;
+            return dot;
+        }
+        static constexpr Vector Lerp(const Vector& start, const Vector& end, T t) requires std::floating_point<T>
+        {
+            return start + (end - start) * t;
+        }
+        static constexpr Vector Max(const Vector& lhs, const Vector& rhs)
+        {
+            return Map(lhs, rhs, [](T a, T b) { return a < b ? b : a; });
+        }
+        static constexpr Vector Min(const Vector& lhs, const Vector& rhs)
+        {
+            return Map(lhs, rhs, [](T a, T b) { return b < a ? b : a; });
+        }
+        static constexpr Vector Scale(const Vector& inVector, const Vector& scalarVector)
+        {
+            return inVector * scalarVector;
+        }
+        // The two-component version expects unit-length inputs; wider vectors normalize both ends first.
+        template<Precision P = Precision::Exact>
+        static constexpr Vector Slerp(const Vector& start, const Vector& end, T t) requires std::floating_point<T>
+        {
+            T dot;
+            Vector relativeVec;
+            if constexpr(N == 2)
+            {
+                dot = ClampUnit(Dot(start, end));
+                relativeVec = end - start * dot;
+            }
+            else
+            {
+                dot = ClampUnit(Dot(start.template Normalized<P>(), end.template Normalized<P>()));
+                relativeVec = (end - start * dot).template Normalized<P>();
+            }
+            const T theta = Acos<P>(dot) * t;
+
+            T sin, cos;
+            SinCos<P>(theta, sin, cos);
+            return start * cos + relativeVec * sin;
+        }
+
+    private:
+        static constexpr Vector Axis(int axis, T value)
+        {
+            Vector result;
+            if(axis == 0) result.x = value;
+            if(axis == 1) result.y = value;
+            if constexpr(N >= 3) if(axis == 2) result.z = value;
+            return result;
+        }
+
+        static constexpr bool ScalarEquals(T a, T b, T epsilon)
+        {
+            const T difference = a - b;
+            return (difference < 0 ? -difference : difference) <= epsilon;
+        }
+
+        static constexpr T ClampUnit(T value)
+        {
+            return value < -1 ? -1 : value > 1 ? 1 : value;
+        }
+
+        template<typename V, typename F>
+        static constexpr Vector Map(const V& a, F f)
+        {
+            if constexpr(N == 2) return Vector(f(a.x), f(a.y));
+            else if constexpr(N == 3) return Vector(f(a.x), f(a.y), f(a.z));
+            else return Vector(f(a.x), f(a.y), f(a.z), f(a.w));
+        }
+
+        template<typename F>
+        static constexpr Vector Map(const Vector& a, const Vector& b, F f)
+        {
+            if constexpr(N == 2) return Vector(f(a.x, b.x), f(a.y, b.y));
+            else if constexpr(N == 3) return Vector(f(a.x, b.x), f(a.y, b.y), f(a.z, b.z));
+            else return Vector(f(a.x, b.x), f(a.y, b.y), f(a.z, b.z), f(a.w, b.w));
+        }
+    };
+
+    // Four float components use the SSE implementation in Vector4.hpp.
+    template<>
+    class Vector<4, float>;
+
+    typedef Vector<2, float> Vector2;
+    typedef Vector<3, float> Vector3;
+    typedef Vector<4, float> Vector4;
+    typedef Vector<2, double> Vector2d;
+    typedef Vector<3, double> Vector3d;
+    typedef Vector<4, double> Vector4d;
+    typedef Vector<2, std::int32_t> Vector2i;
+    typedef Vector<3, std::int32_t> Vector3i;
+    typedef Vector<4, std::int32_t> Vector4i;
+
+    static_assert(std::is_trivially_copyable_v<Vector2> && std::is_standard_layout_v<Vector2>);
+    static_assert(std::is_trivially_copyable_v<Vector3> && std::is_standard_layout_v<Vector3>);
+    static_assert(std::is_trivially_copyable_v<Vector3d> && std::is_standard_layout_v<Vector3d>);
+    static_assert(std::is_trivially_copyable_v<Vector3i> && std::is_standard_layout_v<Vector3i>);
+    static_assert(sizeof(Vector2) == 2 * sizeof(float) && sizeof(Vector3) == 3 * sizeof(float));
+    static_assert(sizeof(Vector4d) == 4 * sizeof(double) && sizeof(Vector4i) == 4 * sizeof(std::int32_t));
+
+    template<int N, typename T>
+    constexpr bool Equals(const Vector<N, T>& lhs, const Vector<N, T>& rhs, std::type_identity_t<T> epsilon = Vector<N, T>::DefaultEpsilon)
+    {
+        return lhs.Equals(rhs, epsilon);
+    }
+
+    template<int N, typename T>
+    constexpr Vector<N, T> operator*(const std::type_identity_t<T> scalar, const Vector<N, T>& vector)
+    {
+        return vector * scalar;
+    }
+    template<int N, typename T>
+    constexpr Vector<N, T> operator/(const std::type_identity_t<T> scalar, const Vector<N, T>& vector)
+    {
+        return Vector<N, T>(scalar) / vector;
+    }
+}
@@ -0,0 +1,233 @@
+﻿#pragma once
+
+#include <cassert>
+#include <span>
+#include <vector>
+#include "WMath/AlignedAllocator.hpp"
+#include "WMath/Utils.hpp"
+#include "WMath/Vector2.hpp"
+
+namespace WMath
+{
+    class Vector2Array
+    {
+    public:
+        typedef std::vector<float, AlignedAllocator<float>> Stream;
+
+        Stream x;
+        Stream y;
+
+        Vector2Array() = default;
+        explicit Vector2Array(std::size_t size) : x(size), y(size) {}
+        Vector2Array(std::size_t size, const Vector2& value) : x(size, value.x), y(size, value.y) {}
+        Vector2Array(std::span<const Vector2> vectors) : Vector2Array(vectors.size())
+        {
+            for(std::size_t i = 0; i < vectors.size(); i++) Set(i, vectors[i]);
+        }
+
+        std::size_t Size() const
+        {
+            return x.size();
+        }
+        bool Empty() const
+        {
+            return x.empty();
+        }
+
+        void Resize(std::size_t size)
+        {
+            x.resize(size);
+            y.resize(size);
+        }
+        void Reserve(std::size_t capacity)
+        {
+            x.reserve(capacity);
+            y.reserve(capacity);
+        }
+        void Clear()
+        {
+            x.clear();
+            y.clear();
+        }
+
+        void PushBack(const Vector2& value)
+        {
+            x.push_back(value.x);
+            y.push_back(value.y);
+        }
+
+        Vector2 Get(std::size_t i) const
+        {
+            return {x[i], y[i]};
+        }
+        void Set(std::size_t i, const Vector2& value)
+        {
+            x[i] = value.x;
+            y[i] = value.y;
+        }
+
+        void CopyTo(std::span<Vector2> out) const
+        {
+            assert(out.size() >= Size());
+            for(std::size_t i = 0; i < Size(); i++) out[i] = Get(i);
+        }
+
+        void Normalize()
+        {
+            Normalize(*this, *this);
+        }
+
+        static void Add(const Vector2Array& lhs, const Vector2Array& rhs, Vector2Array& out)
+        {
+            const std::size_t count = lhs.Size();
+            assert(rhs.Size() == count);
+            out.Resize(count);
+            const float* ax = lhs.x.data(); const float* ay = lhs.y.data();
+            const float* bx = rhs.x.data(); const float* by = rhs.y.data();
+            float* ox = out.x.data(); float* oy = out.y.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                ox[i] = ax[i] + bx[i];
+                oy[i] = ay[i] + by[i];
+            }
+        }
+        static void Subtract(const Vector2Array& lhs, const Vector2Array& rhs, Vector2Array& out)
+        {
+            const std::size_t count = lhs.Size();
+            assert(rhs.Size() == count);
+            out.Resize(count);
+            const float* ax = lhs.x.data(); const float* ay = lhs.y.data();
+            const float* bx = rhs.x.data(); const float* by = rhs.y.data();
+            float* ox = out.x.data(); float* oy = out.y.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                ox[i] = ax[i] - bx[i];
+                oy[i] = ay[i] - by[i];
+            }
+        }
+        static void Scale(const Vector2Array& in, float scalar, Vector2Array& out)
+        {
+            const std::size_t count = in.Size();
+            out.Resize(count);
+            const float* ax = in.x.data(); const float* ay = in.y.data();
+            float* ox = out.x.data(); float* oy = out.y.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                ox[i] = ax[i] * scalar;
+                oy[i] = ay[i] * scalar;
+            }
+        }
+        static void Scale(const Vector2Array& in, const Vector2Array& scalars, Vector2Array& out)
+        {
+            const std::size_t count = in.Size();
+            assert(scalars.Size() == count);
+            out.Resize(count);
+            const float* ax = in.x.data(); const float* ay = in.y.data();
+            const float* bx = scalars.x.data(); const float* by = scalars.y.data();
+            float* ox = out.x.data(); float* oy = out.y.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                ox[i] = ax[i] * bx[i];
+                oy[i] = ay[i] * by[i];
+            }
+        }
+        static void Dot(const Vector2Array& lhs, const Vector2Array& rhs, std::span<float> out)
+        {
+            const std::size_t count = lhs.Size();
+            assert(rhs.Size() == count && out.size() >= count);
+            const float* ax = lhs.x.data(); const float* ay = lhs.y.data();
+            const float* bx = rhs.x.data(); const float* by = rhs.y.data();
+            float* o = out.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                o[i] = ax[i] * bx[i] + ay[i] * by[i];
+            }
+        }
+        static void Cross(const Vector2Array& lhs, const Vector2Array& rhs, std::span<float> out)
+        {
+            const std::size_t count = lhs.Size();
+            assert(rhs.Size() == count && out.size() >= count);
+            const float* ax = lhs.x.data(); const float* ay = lhs.y.data();
+            const float* bx = rhs.x.data(); const float* by = rhs.y.data();
+            float* o = out.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                o[i] = ax[i] * by[i] - ay[i] * bx[i];
+            }
+        }
+        static void Magnitude(const Vector2Array& in, std::span<float> out)
+        {
+            const std::size_t count = in.Size();
+            assert(out.size() >= count);
+            const float* ax = in.x.data(); const float* ay = in.y.data();
+            float* o = out.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                o[i] = std::sqrt(ax[i] * ax[i] + ay[i] * ay[i]);
+            }
+        }
+        static void Normalize(const Vector2Array& in, Vector2Array& out)
+        {
+            const std::size_t count = in.Size();
+            out.Resize(count);
+            const float* ax = in.x.data(); const float* ay = in.y.data();
+            float* ox = out.x.data(); float* oy = out.y.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                const float inverseMagnitude = 1.0f / std::sqrt(ax[i] * ax[i] + ay[i] * ay[i]);
+                ox[i] = ax[i] * inverseMagnitude;
+                oy[i] = ay[i] * inverseMagnitude;
+            }
+        }
+        static void Distance(const Vector2Array& lhs, const Vector2Array& rhs, std::span<float> out)
+        {
+            const std::size_t count = lhs.Size();
+            assert(rhs.Size() == count && out.size() >= count);
+            const float* ax = lhs.x.data(); const float* ay = lhs.y.data();
+            const float* bx = rhs.x.data(); const float* by = rhs.y.data();
+            float* o = out.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                const float dx = ax[i] - bx[i];
+                const float dy = ay[i] - by[i];
+                o[i] = std::sqrt(dx * dx + dy * dy);
+            }
+        }
+        static void Lerp(const Vector2Array& start, const Vector2Array& end, float t, Vector2Array& out)
+        {
+            const std::size_t count = start.Size();
+            assert(end.Size() == count);
+            out.Resize(count);
+            const float* ax = start.x.data(); const float* ay = start.y.data();
+            const float* bx = end.x.data(); const float* by = end.y.data();
+            float* ox = out.x.data(); float* oy = out.y.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                ox[i] = ax[i] + (bx[i] - ax[i]) * t;
+                oy[i] = ay[i] + (by[i] - ay[i]) * t;
+            }
+        }
+        static void Slerp(const Vector2Array& start, const Vector2Array& end, float t, Vector2Array& out)
+        {
+            const std::size_t count = start.Size();
+            assert(end.Size() == count);
+            out.Resize(count);
+            const float* ax = start.x.data(); const float* ay = start.y.data();
+            const float* bx = end.x.data(); const float* by = end.y.data();
+            float* ox = out.x.data(); float* oy = out.y.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                const float dot = Clamp(ax[i] * bx[i] + ay[i] * by[i], -1, 1);
+                const float theta = Acos(dot) * t;
+
+                const float rx = bx[i] - ax[i] * dot;
+                const float ry = by[i] - ay[i] * dot;
+
+                const float cosTheta = Cos(theta);
+                const float sinTheta = Sin(theta);
+                ox[i] = ax[i] * cosTheta + rx * sinTheta;
+                oy[i] = ay[i] * cosTheta + ry * sinTheta;
+            }
+        }
+    };
+}
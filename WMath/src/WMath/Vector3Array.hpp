@@ -0,0 +1,257 @@
+﻿#pragma once
+
+#include <cassert>
+#include <span>
+#include <vector>
+#include "WMath/AlignedAllocator.hpp"
+#include "WMath/Utils.hpp"
+#include "WMath/Vector3.hpp"
+
+namespace WMath
+{
+    class Vector3Array
+    {
+    public:
+        typedef std::vector<float, AlignedAllocator<float>> Stream;
+
+        Stream x;
+        Stream y;
+        Stream z;
+
+        Vector3Array() = default;
+        explicit Vector3Array(std::size_t size) : x(size), y(size), z(size) {}
+        Vector3Array(std::size_t size, const Vector3& value) : x(size, value.x), y(size, value.y), z(size, value.z) {}
+        Vector3Array(std::span<const Vector3> vectors) : Vector3Array(vectors.size())
+        {
+            for(std::size_t i = 0; i < vectors.size(); i++) Set(i, vectors[i]);
+        }
+
+        std::size_t Size() const
+        {
+            return x.size();
+        }
+        bool Empty() const
+        {
+            return x.empty();
+        }
+
+        void Resize(std::size_t size)
+        {
+            x.resize(size);
+            y.resize(size);
+            z.resize(size);
+        }
+        void Reserve(std::size_t capacity)
+        {
+            x.reserve(capacity);
+            y.reserve(capacity);
+            z.reserve(capacity);
+        }
+        void Clear()
+        {
+            x.clear();
+            y.clear();
+            z.clear();
+        }
+
+        void PushBack(const Vector3& value)
+        {
+            x.push_back(value.x);
+            y.push_back(value.y);
+            z.push_back(value.z);
+        }
+
+        Vector3 Get(std::size_t i) const
+        {
+            return {x[i], y[i], z[i]};
+        }
+        void Set(std::size_t i, const Vector3& value)
+        {
+            x[i] = value.x;
+            y[i] = value.y;
+            z[i] = value.z;
+        }
+
+        void CopyTo(std::span<Vector3> out) const
+        {
+            assert(out.size() >= Size());
+            for(std::size_t i = 0; i < Size(); i++) out[i] = Get(i);
+        }
+
+        void Normalize()
+        {
+            Normalize(*this, *this);
+        }
+
+        static void Add(const Vector3Array& lhs, const Vector3Array& rhs, Vector3Array& out)
+        {
+            const std::size_t count = lhs.Size();
+            assert(rhs.Size() == count);
+            out.Resize(count);
+            const float* ax = lhs.x.data(); const float* ay = lhs.y.data(); const float* az = lhs.z.data();
+            const float* bx = rhs.x.data(); const float* by = rhs.y.data(); const float* bz = rhs.z.data();
+            float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                ox[i] = ax[i] + bx[i];
+                oy[i] = ay[i] + by[i];
+                oz[i] = az[i] + bz[i];
+            }
+        }
+        static void Subtract(const Vector3Array& lhs, const Vector3Array& rhs, Vector3Array& out)
+        {
+            const std::size_t count = lhs.Size();
+            assert(rhs.Size() == count);
+            out.Resize(count);
+            const float* ax = lhs.x.data(); const float* ay = lhs.y.data(); const float* az = lhs.z.data();
+            const float* bx = rhs.x.data(); const float* by = rhs.y.data(); const float* bz = rhs.z.data();
+            float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                ox[i] = ax[i] - bx[i];
+                oy[i] = ay[i] - by[i];
+                oz[i] = az[i] - bz[i];
+            }
+        }
+        static void Scale(const Vector3Array& in, float scalar, Vector3Array& out)
+        {
+            const std::size_t count = in.Size();
+            out.Resize(count);
+            const float* ax = in.x.data(); const float* ay = in.y.data(); const float* az = in.z.data();
+            float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                ox[i] = ax[i] * scalar;
+                oy[i] = ay[i] * scalar;
+                oz[i] = az[i] * scalar;
+            }
+        }
+        static void Scale(const Vector3Array& in, const Vector3Array& scalars, Vector3Array& out)
+        {
+            const std::size_t count = in.Size();
+            assert(scalars.Size() == count);
+            out.Resize(count);
+            const float* ax = in.x.data(); const float* ay = in.y.data(); const float* az = in.z.data();
+            const float* bx = scalars.x.data(); const float* by = scalars.y.data(); const float* bz = scalars.z.data();
+            float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                ox[i] = ax[i] * bx[i];
+                oy[i] = ay[i] * by[i];
+                oz[i] = az[i] * bz[i];
+            }
+        }
+        static void Dot(const Vector3Array& lhs, const Vector3Array& rhs, std::span<float> out)
+        {
+            const std::size_t count = lhs.Size();
+            assert(rhs.Size() == count && out.size() >= count);
+            const float* ax = lhs.x.data(); const float* ay = lhs.y.data(); const float* az = lhs.z.data();
+            const float* bx = rhs.x.data(); const float* by = rhs.y.data(); const float* bz = rhs.z.data();
+            float* o = out.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                o[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+            }
+        }
+        static void Cross(const Vector3Array& lhs, const Vector3Array& rhs, Vector3Array& out)
+        {
+            const std::size_t count = lhs.Size();
+            assert(rhs.Size() == count);
+            out.Resize(count);
+            const float* ax = lhs.x.data(); const float* ay = lhs.y.data(); const float* az = lhs.z.data();
+            const float* bx = rhs.x.data(); const float* by = rhs.y.data(); const float* bz = rhs.z.data();
+            float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                const float cx = ay[i] * bz[i] - az[i] * by[i];
+                const float cy = az[i] * bx[i] - ax[i] * bz[i];
+                const float cz = ax[i] * by[i] - ay[i] * bx[i];
+                ox[i] = cx;
+                oy[i] = cy;
+                oz[i] = cz;
+            }
+        }
+        static void Magnitude(const Vector3Array& in, std::span<float> out)
+        {
+            const std::size_t count = in.Size();
+            assert(out.size() >= count);
+            const float* ax = in.x.data(); const float* ay = in.y.data(); const float* az = in.z.data();
+            float* o = out.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                o[i] = std::sqrt(ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i]);
+            }
+        }
+        static void Normalize(const Vector3Array& in, Vector3Array& out)
+        {
+            const std::size_t count = in.Size();
+            out.Resize(count);
+            const float* ax = in.x.data(); const float* ay = in.y.data(); const float* az = in.z.data();
+            float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                const float inverseMagnitude = 1.0f / std::sqrt(ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i]);
+                ox[i] = ax[i] * inverseMagnitude;
+                oy[i] = ay[i] * inverseMagnitude;
+                oz[i] = az[i] * inverseMagnitude;
+            }
+        }
+        static void Distance(const Vector3Array& lhs, const Vector3Array& rhs, std::span<float> out)
+        {
+            const std::size_t count = lhs.Size();
+            assert(rhs.Size() == count && out.size() >= count);
+            const float* ax = lhs.x.data(); const float* ay = lhs.y.data(); const float* az = lhs.z.data();
+            const float* bx = rhs.x.data(); const float* by = rhs.y.data(); const float* bz = rhs.z.data();
+            float* o = out.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                const float dx = ax[i] - bx[i];
+                const float dy = ay[i] - by[i];
+                const float dz = az[i] - bz[i];
+                o[i] = std::sqrt(dx * dx + dy * dy + dz * dz);
+            }
+        }
+        static void Lerp(const Vector3Array& start, const Vector3Array& end, float t, Vector3Array& out)
+        {
+            const std::size_t count = start.Size();
+            assert(end.Size() == count);
+            out.Resize(count);
+            const float* ax = start.x.data(); const float* ay = start.y.data(); const float* az = start.z.data();
+            const float* bx = end.x.data(); const float* by = end.y.data(); const float* bz = end.z.data();
+            float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                ox[i] = ax[i] + (bx[i] - ax[i]) * t;
+                oy[i] = ay[i] + (by[i] - ay[i]) * t;
+                oz[i] = az[i] + (bz[i] - az[i]) * t;
+            }
+        }
+        static void Slerp(const Vector3Array& start, const Vector3Array& end, float t, Vector3Array& out)
+        {
+            const std::size_t count = start.Size();
+            assert(end.Size() == count);
+            out.Resize(count);
+            const float* ax = start.x.data(); const float* ay = start.y.data(); const float* az = start.z.data();
+            const float* bx = end.x.data(); const float* by = end.y.data(); const float* bz = end.z.data();
+            float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+            for(std::size_t i = 0; i < count; i++)
+            {
+                const float startMagnitude = std::sqrt(ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i]);
+                const float endMagnitude = std::sqrt(bx[i] * bx[i] + by[i] * by[i] + bz[i] * bz[i]);
+                const float dot = Clamp((ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i]) / (startMagnitude * endMagnitude), -1, 1);
+                const float theta = Acos(dot) * t;
+
+                const float rx = bx[i] - ax[i] * dot;
+                const float ry = by[i] - ay[i] * dot;
+                const float rz = bz[i] - az[i] * dot;
+                const float inverseRelative = 1.0f / std::sqrt(rx * rx + ry * ry + rz * rz);
+
+                const float cosTheta = Cos(theta);
+                const float sinTheta = Sin(theta) * inverseRelative;
+                ox[i] = ax[i] * cosTheta + rx * sinTheta;
+                oy[i] = ay[i] * cosTheta + ry * sinTheta;
+                oz[i] = az[i] * cosTheta + rz * sinTheta;
+            }
+        }
+    };
+}
@@ -0,0 +1,297 @@
+﻿#pragma once
+
+#include <string>
+#include <type_traits>
+#include "WMath/Simd.hpp"
+#include "WMath/Utils.hpp"
+#include "WMath/Vector.hpp"
+
+namespace WMath
+{
+    // SSE specialization of the generic Vector template for four float components. It has the same members and
+    // signatures as the primary template, so generic code over Vector<N, T> also compiles for Vector4; in constant
+    // evaluation every member takes the scalar path.
+    template<>
+    class alignas(16) Vector<4, float>
+    {
+    public:
+        typedef float ValueType;
+
+        static constexpr int Dimensions = 4;
+        static constexpr float DefaultEpsilon = Epsilon;
+
+        static constexpr Vector4 Zero() { return {0, 0, 0, 0}; }
+        static constexpr Vector4 One() { return {1, 1, 1, 1}; }
+
+        static constexpr Vector4 Up() { return {0, 1, 0, 0}; }
+        static constexpr Vector4 Down() { return {0, -1, 0, 0}; }
+        static constexpr Vector4 Left() { return {-1, 0, 0, 0}; }
+        static constexpr Vector4 Right() { return {1, 0, 0, 0}; }
+        static constexpr Vector4 Forward() { return {0, 0, 1, 0}; }
+        static constexpr Vector4 Back() { return {0, 0, -1, 0}; }
+
+        float x;
+        float y;
+        float z;
+        float w;
+
+        constexpr Vector() : x(0), y(0), z(0), w(0) {}
+        constexpr Vector(float value) : x(value), y(value), z(value), w(value) {}
+        constexpr Vector(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+        constexpr Vector(const Vector3& vec3, float w = 0) : x(vec3.x), y(vec3.y), z(vec3.z), w(w) {}
+
+        template<typename U>
+        constexpr explicit Vector(const Vector<4, U>& other)
+            : x(static_cast<float>(other.x)), y(static_cast<float>(other.y)), z(static_cast<float>(other.z)), w(static_cast<float>(other.w))
+        {
+        }
+
+#if defined(WMATH_SSE2)
+        Vector(__m128 value)
+        {
+            _mm_store_ps(&x, value);
+        }
+
+        __m128 Load() const
+        {
+            return _mm_load_ps(&x);
+        }
+#endif
+
+        constexpr float operator[](int i) const
+        {
+            if(i == 0) return x;
+            if(i == 1) return y;
+            if(i == 2) return z;
+            if(i == 3) return w;
+            return 0;
+        }
+
+        constexpr explicit operator Vector3() const
+        {
+            return ToVector3();
+        }
+        constexpr Vector3 ToVector3() const
+        {
+            return {x, y, z};
+        }
+        constexpr Vector3 Homogenized() const
+        {
+            const float inverseW = 1.0f / w;
+            return {x * inverseW, y * inverseW, z * inverseW};
+        }
+
+        constexpr int operator<=>(const Vector4& other) const
+        {
+            if(WMath::Equals(MagnitudeSquared(), other.MagnitudeSquared(), DefaultEpsilon)) return 0;
+            return MagnitudeSquared() < other.MagnitudeSquared() ? -1 : 1;
+        }
+        constexpr bool operator==(const Vector4& other) const
+        {
+            return Equals(other);
+        }
+        constexpr bool operator!=(const Vector4& other) const
+        {
+            return !Equals(other);
+        }
+
+        constexpr Vector4 operator+(const Vector4& other) const
+        {
+#if defined(WMATH_SSE2)
+            if(!std::is_constant_evaluated()) return _mm_add_ps(Load(), other.Load());
+#endif
+            return {x + other.x, y + other.y, z + other.z, w + other.w};
+        }
+        constexpr Vector4& operator+=(const Vector4& other)
+        {
+            return *this = *this + other;
+        }
+
+        constexpr Vector4 operator-(const Vector4& other) const
+        {
+#if defined(WMATH_SSE2)
+            if(!std::is_constant_evaluated()) return _mm_sub_ps(Load(), other.Load());
+#endif
+            return {x - other.x, y - other.y, z - other.z, w - other.w};
+        }
+        constexpr Vector4& operator-=(const Vector4& other)
+        {
+            return *this = *this - other;
+        }
+
+        constexpr Vector4 operator*(const float scalar) const
+        {
+#if defined(WMATH_SSE2)
+            if(!std::is_constant_evaluated()) return _mm_mul_ps(Load(), _mm_set1_ps(scalar));
+#endif
+            return {x * scalar, y * scalar, z * scalar, w * scalar};
+        }
+        constexpr Vector4& operator*=(const float scalar)
+        {
+            return *this = *this * scalar;
+        }
+        constexpr Vector4 operator*(const Vector4& other) const
+        {
+#if defined(WMATH_SSE2)
+            if(!std::is_constant_evaluated()) return _mm_mul_ps(Load(), other.Load());
+#endif
+            return {x * other.x, y * other.y, z * other.z, w * other.w};
+        }
+        constexpr Vector4& operator*=(const Vector4& other)
+        {
+            return *this = *this * other;
+        }
+
+        constexpr Vector4 operator/(const float scalar) const
+        {
+#if defined(WMATH_SSE2)
+            if(!std::is_constant_evaluated()) return _mm_div_ps(Load(), _mm_set1_ps(scalar));
+#endif
+            return {x / scalar, y / scalar, z / scalar, w / scalar};
+        }
+        constexpr Vector4& operator/=(const float scalar)
+        {
+            return *this = *this / scalar;
+        }
+        constexpr Vector4 operator/(const Vector4& other) const
+        {
+#if defined(WMATH_SSE2)
+            if(!std::is_constant_evaluated()) return _mm_div_ps(Load(), other.Load());
+#endif
+            return {x / other.x, y / other.y, z / other.z, w / other.w};
+        }
+        constexpr Vector4& operator/=(const Vector4& other)
+        {
+            return *this = *this / other;
+        }
+
+        constexpr bool Equals(const Vector4& other, float epsilon = DefaultEpsilon) const
+        {
+#if defined(WMATH_SSE2)
+            if(!std::is_constant_evaluated())
+            {
+                const __m128 difference = _mm_sub_ps(Load(), other.Load());
+                const __m128 absolute = _mm_andnot_ps(_mm_set1_ps(-0.0f), difference);
+                return _mm_movemask_ps(_mm_cmple_ps(absolute, _mm_set1_ps(epsilon))) == 0xF;
+            }
+#endif
+            return WMath::Equals(x, other.x, epsilon) && WMath::Equals(y, other.y, epsilon) &&
+                WMath::Equals(z, other.z, epsilon) && WMath::Equals(w, other.w, epsilon);
+        }
+
+        template<Precision P = Precision::Exact>
+        constexpr float Magnitude() const
+        {
+            return Sqrt<P>(MagnitudeSquared());
+        }
+        constexpr float Length() const
+        {
+            return Magnitude();
+        }
+
+        constexpr float MagnitudeSquared() const
+        {
+            return Dot(*this, *this);
+        }
+        constexpr float LengthSquared() const
+        {
+            return MagnitudeSquared();
+        }
+
+        template<Precision P = Precision::Exact>
+        constexpr Vector4 Normalized() const
+        {
+            if constexpr(P == Precision::Fast) return *this * InvSqrt<P>(MagnitudeSquared());
+#if defined(WMATH_SSE2)
+            if(!std::is_constant_evaluated())
+            {
+                const __m128 value = Load();
+                return _mm_div_ps(value, _mm_sqrt_ps(DotSplat(value, value)));
+            }
+#endif
+            return *this / Magnitude();
+        }
+        template<Precision P = Precision::Exact>
+        constexpr void Normalize()
+        {
+            *this = Normalized<P>();
+        }
+
+        std::string ToString() const
+        {
+            return "(" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ", " + std::to_string(w) + ")";
+        }
+
+        template<Precision P = Precision::Exact>
+        static constexpr float AbsAngle(const Vector4& lhs, const Vector4& rhs)
+        {
+            const float dot = Clamp(Dot(lhs.Normalized<P>(), rhs.Normalized<P>()), -1.0f, 1.0f);
+            return Acos<P>(dot) * Rad2Deg;
+        }
+        template<Precision P = Precision::Exact>
+        static constexpr float Distance(const Vector4& lhs, const Vector4& rhs)
+        {
+            return (lhs - rhs).Magnitude<P>();
+        }
+        static constexpr float Dot(const Vector4& lhs, const Vector4& rhs)
+        {
+#if defined(WMATH_SSE2)
+            if(!std::is_constant_evaluated()) return _mm_cvtss_f32(DotSplat(lhs.Load(), rhs.Load()));
+#endif
+            return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z + lhs.w * rhs.w;
+        }
+        static constexpr Vector4 Lerp(const Vector4& start, const Vector4& end, float t)
+        {
+            return start + (end - start) * t;
+        }
+        static constexpr Vector4 Max(const Vector4& lhs, const Vector4& rhs)
+        {
+#if defined(WMATH_SSE2)
+            if(!std::is_constant_evaluated()) return _mm_max_ps(lhs.Load(), rhs.Load());
+#endif
+            return {WMath::Max(lhs.x, rhs.x), WMath::Max(lhs.y, rhs.y), WMath::Max(lhs.z, rhs.z), WMath::Max(lhs.w, rhs.w)};
+        }
+        static constexpr Vector4 Min(const Vector4& lhs, const Vector4& rhs)
+        {
+#if defined(WMATH_SSE2)
+            if(!std::is_constant_evaluated()) return _mm_min_ps(lhs.Load(), rhs.Load());
+#endif
+            return {WMath::Min(lhs.x, rhs.x), WMath::Min(lhs.y, rhs.y), WMath::Min(lhs.z, rhs.z), WMath::Min(lhs.w, rhs.w)};
+        }
+        static constexpr Vector4 Scale(const Vector4& inVector, const Vector4& scalarVector)
+        {
+            return inVector * scalarVector;
+        }
+        // Normalizes both ends first, like the primary template for three or more components.
+        template<Precision P = Precision::Exact>
+        static constexpr Vector4 Slerp(const Vector4& start, const Vector4& end, float t)
+        {
+            const float dot = Clamp(Dot(start.Normalized<P>(), end.Normalized<P>()), -1.0f, 1.0f);
+            const Vector4 relativeVec = (end - start * dot).Normalized<P>();
+            const float theta = Acos<P>(dot) * t;
+
+            float sin = 0.0f, cos = 0.0f;
+            SinCos<P>(theta, sin, cos);
+            return start * cos + relativeVec * sin;
+        }
+
+    private:
+#if defined(WMATH_SSE2)
+        static __m128 DotSplat(__m128 lhs, __m128 rhs)
+        {
+#if defined(WMATH_SSE4_1)
+            return _mm_dp_ps(lhs, rhs, 0xFF);
+#else
+            const __m128 product = _mm_mul_ps(lhs, rhs);
+            const __m128 swapped = _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_add_ps(swapped, _mm_shuffle_ps(swapped, swapped, _MM_SHUFFLE(1, 0, 3, 2)));
+#endif
+        }
+#endif
+    };
+
+    static_assert(std::is_trivially_copyable_v<Vector4> && std::is_standard_layout_v<Vector4>);
+    static_assert(sizeof(Vector4) == 4 * sizeof(float));
+    static_assert(Vector4(0, 3, 0, 4).Magnitude<Precision::Fast>() == 5.0f && Vector4::Distance<Precision::Fast>(Vector4::One(), Vector4::Zero()) == 2.0f);
+    static_assert(WMath::Equals(2.0f * Vector4(1, 0, 0, 0).Normalized<Precision::Fast>(), Vector4(2, 0, 0, 0)));
+}
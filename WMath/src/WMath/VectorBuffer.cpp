@@ -0,0 +1,190 @@
+﻿#include "VectorBuffer.hpp"
+
+#include <bit>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr bool IsNativeLittleEndian = std::endian::native == std::endian::little;
+
+    std::uint32_t ElementSize(WMath::VectorBufferType type)
+    {
+        switch(type)
+        {
+        case WMath::VectorBufferType::Float: return sizeof(float);
+        case WMath::VectorBufferType::Vector2: return sizeof(WMath::Vector2);
+        case WMath::VectorBufferType::Vector3: return sizeof(WMath::Vector3);
+        case WMath::VectorBufferType::Vector4: return sizeof(WMath::Vector4);
+        }
+        return 0;
+    }
+
+    bool IsValid(const WMath::VectorBufferHeader& header, std::size_t fileSize)
+    {
+        if(header.signature != WMath::VectorBufferHeader::Signature) return false;
+        if(header.version == 0 || header.version > WMath::VectorBufferHeader::CurrentVersion) return false;
+        if(header.elementSize == 0 || header.elementSize != ElementSize(header.type)) return false;
+        if(header.dataOffset < sizeof(WMath::VectorBufferHeader) || header.dataOffset % WMath::VectorBufferHeader::DataAlignment != 0) return false;
+        if(header.dataOffset > fileSize) return false;
+        return header.count <= (fileSize - header.dataOffset) / header.elementSize;
+    }
+
+    const std::byte* Map(const std::string& path, std::size_t& size)
+    {
+#if defined(_WIN32)
+        const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(file == INVALID_HANDLE_VALUE) return nullptr;
+
+        LARGE_INTEGER fileSize;
+        if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(WMath::VectorBufferHeader)))
+        {
+            CloseHandle(file);
+            return nullptr;
+        }
+
+        const HANDLE fileMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if(fileMapping == nullptr) return nullptr;
+
+        const void* view = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(fileMapping);
+        if(view == nullptr) return nullptr;
+
+        size = static_cast<std::size_t>(fileSize.QuadPart);
+        return static_cast<const std::byte*>(view);
+#else
+        const int file = open(path.c_str(), O_RDONLY);
+        if(file < 0) return nullptr;
+
+        struct stat status;
+        if(fstat(file, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(WMath::VectorBufferHeader)))
+        {
+            close(file);
+            return nullptr;
+        }
+
+        void* view = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if(view == MAP_FAILED) return nullptr;
+
+        size = static_cast<std::size_t>(status.st_size);
+        return static_cast<const std::byte*>(view);
+#endif
+    }
+
+    void Unmap(const std::byte* mapping, std::size_t size)
+    {
+#if defined(_WIN32)
+        (void)size;
+        UnmapViewOfFile(mapping);
+#else
+        munmap(const_cast<std::byte*>(mapping), size);
+#endif
+    }
+}
+
+WMath::VectorBuffer::VectorBuffer(VectorBuffer&& other) noexcept
+    : mapping(std::exchange(other.mapping, nullptr)), mappingSize(std::exchange(other.mappingSize, 0))
+{
+}
+
+WMath::VectorBuffer::~VectorBuffer()
+{
+    Close();
+}
+
+WMath::VectorBuffer& WMath::VectorBuffer::operator=(VectorBuffer&& other) noexcept
+{
+    if(this == &other) return *this;
+
+    Close();
+    mapping = std::exchange(other.mapping, nullptr);
+    mappingSize = std::exchange(other.mappingSize, 0);
+
+    return *this;
+}
+
+bool WMath::VectorBuffer::Open(const std::string& path)
+{
+    Close();
+    if constexpr(!IsNativeLittleEndian) return false;
+
+    std::size_t size = 0;
+    const std::byte* view = Map(path, size);
+    if(view == nullptr) return false;
+
+    if(!IsValid(*reinterpret_cast<const VectorBufferHeader*>(view), size))
+    {
+        Unmap(view, size);
+        return false;
+    }
+
+    mapping = view;
+    mappingSize = size;
+    return true;
+}
+
+void WMath::VectorBuffer::Close()
+{
+    if(mapping == nullptr) return;
+
+    Unmap(mapping, mappingSize);
+    mapping = nullptr;
+    mappingSize = 0;
+}
+
+bool WMath::VectorBuffer::WriteRaw(const std::string& path, VectorBufferType type, std::uint32_t elementSize, const void* data, std::size_t count)
+{
+    if constexpr(!IsNativeLittleEndian) return false;
+
+    const VectorBufferHeader header =
+    {
+        VectorBufferHeader::Signature,
+        VectorBufferHeader::CurrentVersion,
+        type,
+        elementSize,
+        count,
+        VectorBufferHeader::DataAlignment
+    };
+    constexpr char padding[VectorBufferHeader::DataAlignment - sizeof(VectorBufferHeader)] = {};
+
+    // Writes go to a temporary file that replaces the target only once complete, so readers never map a partial file.
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if(!file) return false;
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(padding, sizeof(padding));
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(count * elementSize));
+        if(!file.flush())
+        {
+            file.close();
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    if(error)
+    {
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
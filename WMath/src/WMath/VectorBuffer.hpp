@@ -0,0 +1,124 @@
+﻿#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+#include "WMath/Vector2.hpp"
+#include "WMath/Vector3.hpp"
+#include "WMath/Vector4.hpp"
+
+namespace WMath
+{
+    enum class VectorBufferType : std::uint32_t
+    {
+        Float = 1,
+        Vector2 = 2,
+        Vector3 = 3,
+        Vector4 = 4
+    };
+
+    // Little-endian file layout: this header, zero padding up to dataOffset, then count tightly packed elements.
+    struct VectorBufferHeader
+    {
+        static constexpr std::uint32_t Signature = 0x42564D57;
+        static constexpr std::uint32_t CurrentVersion = 1;
+        static constexpr std::uint64_t DataAlignment = 64;
+
+        std::uint32_t signature;
+        std::uint32_t version;
+        VectorBufferType type;
+        std::uint32_t elementSize;
+        std::uint64_t count;
+        std::uint64_t dataOffset;
+    };
+
+    static_assert(sizeof(VectorBufferHeader) == 32 && std::is_standard_layout_v<VectorBufferHeader>);
+
+    template<typename T> struct VectorBufferElement;
+    template<> struct VectorBufferElement<float> { static constexpr VectorBufferType Type = VectorBufferType::Float; };
+    template<> struct VectorBufferElement<Vector2> { static constexpr VectorBufferType Type = VectorBufferType::Vector2; };
+    template<> struct VectorBufferElement<Vector3> { static constexpr VectorBufferType Type = VectorBufferType::Vector3; };
+    template<> struct VectorBufferElement<Vector4> { static constexpr VectorBufferType Type = VectorBufferType::Vector4; };
+
+    template<typename T>
+    concept VectorBufferElementType = std::is_trivially_copyable_v<T> && requires { VectorBufferElement<T>::Type; };
+
+    // Read-only memory mapping of a file written by VectorBuffer::Write. Get returns spans straight into the mapping,
+    // which stay valid until the buffer is closed, reopened or destroyed.
+    class VectorBuffer
+    {
+    public:
+        static bool Write(const std::string& path, std::span<const float> elements)
+        {
+            return Write<float>(path, elements);
+        }
+        static bool Write(const std::string& path, std::span<const Vector2> elements)
+        {
+            return Write<Vector2>(path, elements);
+        }
+        static bool Write(const std::string& path, std::span<const Vector3> elements)
+        {
+            return Write<Vector3>(path, elements);
+        }
+        static bool Write(const std::string& path, std::span<const Vector4> elements)
+        {
+            return Write<Vector4>(path, elements);
+        }
+
+        VectorBuffer() = default;
+        explicit VectorBuffer(const std::string& path)
+        {
+            Open(path);
+        }
+        VectorBuffer(const VectorBuffer& other) = delete;
+        VectorBuffer(VectorBuffer&& other) noexcept;
+
+        ~VectorBuffer();
+
+        VectorBuffer& operator=(const VectorBuffer& other) = delete;
+        VectorBuffer& operator=(VectorBuffer&& other) noexcept;
+
+        bool Open(const std::string& path);
+        void Close();
+
+        bool IsOpen() const
+        {
+            return mapping != nullptr;
+        }
+        VectorBufferType GetType() const
+        {
+            assert(IsOpen());
+            return GetHeader().type;
+        }
+        std::size_t Size() const
+        {
+            return IsOpen() ? static_cast<std::size_t>(GetHeader().count) : 0;
+        }
+
+        template<VectorBufferElementType T>
+        std::span<const T> Get() const
+        {
+            if(!IsOpen() || GetHeader().type != VectorBufferElement<T>::Type) return {};
+            return {reinterpret_cast<const T*>(mapping + GetHeader().dataOffset), Size()};
+        }
+
+    private:
+        const std::byte* mapping = nullptr;
+        std::size_t mappingSize = 0;
+
+        const VectorBufferHeader& GetHeader() const
+        {
+            return *reinterpret_cast<const VectorBufferHeader*>(mapping);
+        }
+
+        template<VectorBufferElementType T>
+        static bool Write(const std::string& path, std::span<const T> elements)
+        {
+            return WriteRaw(path, VectorBufferElement<T>::Type, sizeof(T), elements.data(), elements.size());
+        }
+        static bool WriteRaw(const std::string& path, VectorBufferType type, std::uint32_t elementSize, const void* data, std::size_t count);
+    };
+}
@@ -1,7 +1,35 @@
 ﻿#pragma once
 
+#include "WMath/ConstexprMath.hpp"
 #include "WMath/Utils.hpp"
+#include "WMath/FastMath.hpp"
+#include "WMath/BatchMath.hpp"
+#include "WMath/ThreadPool.hpp"
+#include "WMath/Parallel.hpp"
+#include "WMath/OpenSimplex2S.hpp"
 #include "WMath/Random.hpp"
+#include "WMath/RandomEngines.hpp"
+#include "WMath/RandomStream.hpp"
+#include "WMath/CounterRandom.hpp"
+#include "WMath/Sampling.hpp"
+#include "WMath/Vector.hpp"
 #include "WMath/Vector2.hpp"
 #include "WMath/Vector3.hpp"
-#include "WMath/Vector4.hpp"
\ No newline at end of file
+#include "WMath/Vector2Array.hpp"
+#include "WMath/Vector3Array.hpp"
+#include "WMath/Vector4.hpp"
+#include "WMath/Matrix4x4.hpp"
+#include "WMath/VectorBuffer.hpp"
+#include "WMath/Quantization.hpp"
+#include "WMath/Half.hpp"
+#include "WMath/KdTree.hpp"
+#include "WMath/Broadphase.hpp"
+#include "WMath/Ray.hpp"
+#include "WMath/AABB.hpp"
+#include "WMath/Sphere.hpp"
+#include "WMath/Plane.hpp"
+#include "WMath/Triangle.hpp"
+#include "WMath/GeometryBatch.hpp"
+#include "WMath/Frustum.hpp"
+#include "WMath/Culling.hpp"
+#include "WMath/Particles.hpp"